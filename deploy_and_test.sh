@@ -1,14 +1,36 @@
 #!/bin/bash
 
 # 脚本功能：将 outputs 目录下的测试文件复制到正确位置，编译并执行测试
-# 使用方法: ./deploy_and_test.sh [--build-only] [--test-only]
+# 使用方法: ./deploy_and_test.sh [--build-only] [--test-only] [--perf-gate] [--alloc-hook] [--workspace-check] [--tiling-snapshot record|verify]
 
 set -e
 
 # 配置路径
 UTGEN_TARGET_DIR="/workspace/UTGen-V2/outputs"
-OPS_TRANSFORMER_DIR="/workspace/ops-transformer-dev"
+# 生成用例共用的头文件 (日志等)，随测试文件一同部署
+UTGEN_INCLUDE_DIR="/workspace/UTGen-V2/template/include"
+OPS_TRANSFORMER_DIR="${OPS_TRANSFORMER_DIR:-/workspace/ops-transformer-dev}"
 MC2_DIR="${OPS_TRANSFORMER_DIR}/mc2"
+# tiling 性能门禁：耗时历史按 ops-transformer commit 记录在本地 SQLite 中
+UTGEN_PERF_GATE="/workspace/UTGen-V2/utils/perf_gate.py"
+PERF_GATE_DB="${PERF_GATE_DB:-/workspace/UTGen-V2/perf_history.sqlite}"
+PERF_GATE_REPORT_DIR="${OPS_TRANSFORMER_DIR}/build/utgen_perf_report"
+PERF_GATE_REPEAT="${PERF_GATE_REPEAT:-5}"
+PERF_GATE_THRESHOLD="${PERF_GATE_THRESHOLD:-0.10}"
+# 堆分配 hook 库：重新链接 UT 可执行文件后统计每次 tiling 的分配 (见 utgen_alloc_stats.h)
+UTGEN_ALLOC_HOOK_SRC="/workspace/UTGen-V2/runner/utgen_alloc_hook.cpp"
+UT_BUILD_DIR="${OPS_TRANSFORMER_DIR}/build/tests/ut/framework_normal/op_host"
+UT_LINK_TXT="${UT_BUILD_DIR}/CMakeFiles/transformer_op_host_ut.dir/link.txt"
+# 链接 hook 后的可执行文件另起名字，不覆盖 CMake 产出的 transformer_op_host_ut
+ALLOC_HOOK_UT_BINARY="${UT_BUILD_DIR}/transformer_op_host_ut_alloc_hook"
+# workspace / tiling data 长度 golden：首次运行时生成，之后逐用例比对增长
+UTGEN_WORKSPACE_GOLDEN="/workspace/UTGen-V2/utils/workspace_golden.py"
+WORKSPACE_GOLDEN_FILE="${WORKSPACE_GOLDEN_FILE:-/workspace/UTGen-V2/golden/workspace_golden.json}"
+WORKSPACE_REPORT_DIR="${OPS_TRANSFORMER_DIR}/build/utgen_workspace_report"
+UTGEN_TILING_DATA_USAGE="/workspace/UTGen-V2/utils/tiling_data_usage.py"
+# tiling 结果快照：record 记录每个用例完整的 tiling data / block dim / workspace，verify 逐字节比对
+TILING_STORE_FILE="${TILING_STORE_FILE:-/workspace/UTGen-V2/golden/tiling.store}"
+UTGEN_TILING_STORE_TOOL="/workspace/UTGen-V2/utils/tiling_store.py"
 
 # 颜色输出
 RED='\033[0;31m'
@@ -64,6 +86,7 @@ deploy_test_files() {
         
         log_info "复制 $filename -> $target_dir/"
         cp "$file" "$target_dir/"
+        cp "${UTGEN_INCLUDE_DIR}"/*.h "$target_dir/"
         
         deployed_ops+=("$op_name")
     done
@@ -96,17 +119,30 @@ build_ops() {
     log_info "编译完成"
 }
 
-# 执行测试
-run_tests() {
-    log_info "开始执行测试..."
+# 把分配 hook 库链接进 UT 可执行文件：复用 CMake 生成的链接命令，追加 hook 目标文件并输出到
+# $ALLOC_HOOK_UT_BINARY，后续测试改用该文件；可执行文件中的 malloc/free 强符号优先于 glibc，无需 LD_PRELOAD
+link_alloc_hook() {
+    log_info "链接堆分配 hook 库..."
     
-    cd "${OPS_TRANSFORMER_DIR}"
+    if [[ ! -f "$UT_LINK_TXT" ]]; then
+        log_error "未找到 $UT_LINK_TXT，请先完整编译一次 transformer_op_host_ut"
+        exit 1
+    fi
     
-    # 设置 BUILD_PATH 环境变量（测试框架需要）
-    export BUILD_PATH="${OPS_TRANSFORMER_DIR}/build"
-    log_info "设置 BUILD_PATH=${BUILD_PATH}"
+    local hook_obj="${OPS_TRANSFORMER_DIR}/build/utgen_alloc_hook.o"
+    ${CXX:-g++} -std=c++17 -O2 -fPIC -c "$UTGEN_ALLOC_HOOK_SRC" -o "$hook_obj"
+    local link_cmd=$(sed -E "s#-o +[^ ]*transformer_op_host_ut( |$)#-o $ALLOC_HOOK_UT_BINARY\1#" "$UT_LINK_TXT")
+    (cd "$UT_BUILD_DIR" && eval "$link_cmd $hook_obj")
+    UT_BINARY="$ALLOC_HOOK_UT_BINARY"
     
-    # 查找 transformer_op_host_ut 可执行文件
+    log_info "hook 库链接完成: $ALLOC_HOOK_UT_BINARY，UTGEN_REPORT_DIR 报告中将包含每个用例的 allocs/allocBytes/peakLiveBytes"
+}
+
+# 查找 transformer_op_host_ut 可执行文件，结果写入 UT_BINARY；已链接 hook 库时沿用 hook 版本
+find_ut_binary() {
+    if [[ -n "$UT_BINARY" ]]; then
+        return
+    fi
     local ut_binary=$(find . -name "transformer_op_host_ut" -type f -executable 2>/dev/null | head -1)
     
     if [[ -z "$ut_binary" ]]; then
@@ -122,13 +158,118 @@ run_tests() {
             exit 1
         fi
     fi
+    UT_BINARY="$ut_binary"
+}
+
+# 执行测试
+run_tests() {
+    log_info "开始执行测试..."
+    
+    cd "${OPS_TRANSFORMER_DIR}"
     
-    log_info "执行测试: $ut_binary --gtest_filter='*Tiling*:-*InferShape*'"
-    "$ut_binary" --gtest_filter='*Tiling*:-*InferShape*'
+    # 设置 BUILD_PATH 环境变量（测试框架需要）
+    export BUILD_PATH="${OPS_TRANSFORMER_DIR}/build"
+    log_info "设置 BUILD_PATH=${BUILD_PATH}"
+    
+    find_ut_binary
+    
+    log_info "执行测试: $UT_BINARY --gtest_filter='*Tiling*:-*InferShape*'"
+    "$UT_BINARY" --gtest_filter='*Tiling*:-*InferShape*'
     
     log_info "测试完成"
 }
 
+# tiling 性能门禁：重复执行用例采集每个用例的 tiling 耗时，与历史基线比较，回归时失败
+run_perf_gate() {
+    log_info "开始 tiling 性能门禁..."
+    
+    cd "${OPS_TRANSFORMER_DIR}"
+    export BUILD_PATH="${OPS_TRANSFORMER_DIR}/build"
+    find_ut_binary
+    
+    rm -rf "$PERF_GATE_REPORT_DIR"
+    mkdir -p "$PERF_GATE_REPORT_DIR"
+    log_info "采集 tiling 耗时: 重复 ${PERF_GATE_REPEAT} 次"
+    UTGEN_REPORT_DIR="$PERF_GATE_REPORT_DIR" "$UT_BINARY" --gtest_filter='*Tiling*:-*InferShape*' \
+        --gtest_repeat="$PERF_GATE_REPEAT" > "$PERF_GATE_REPORT_DIR/ut.log" 2>&1 || {
+        log_error "采集耗时时测试失败，详见 $PERF_GATE_REPORT_DIR/ut.log"
+        exit 1
+    }
+    
+    if ! python3 "$UTGEN_PERF_GATE" --db "$PERF_GATE_DB" check "$PERF_GATE_REPORT_DIR/tiling_latency.json" \
+        --repo "$OPS_TRANSFORMER_DIR" --threshold "$PERF_GATE_THRESHOLD" \
+        --json "$PERF_GATE_REPORT_DIR/perf_gate.json" --record; then
+        log_error "tiling 性能门禁未通过，详见 $PERF_GATE_REPORT_DIR/perf_gate.json"
+        exit 1
+    fi
+    
+    log_info "tiling 性能门禁通过"
+}
+
+# workspace 检查：采集每个用例的 workspace 与 tiling data 长度，与 golden 比对，有增长时失败
+run_workspace_check() {
+    log_info "开始 workspace 检查..."
+    
+    cd "${OPS_TRANSFORMER_DIR}"
+    export BUILD_PATH="${OPS_TRANSFORMER_DIR}/build"
+    find_ut_binary
+    
+    rm -rf "$WORKSPACE_REPORT_DIR"
+    mkdir -p "$WORKSPACE_REPORT_DIR"
+    UTGEN_REPORT_DIR="$WORKSPACE_REPORT_DIR" "$UT_BINARY" --gtest_filter='*Tiling*:-*InferShape*' \
+        > "$WORKSPACE_REPORT_DIR/ut.log" 2>&1 || {
+        log_error "采集 workspace 时测试失败，详见 $WORKSPACE_REPORT_DIR/ut.log"
+        exit 1
+    }
+    
+    # tiling data 利用率只做报告，不影响 workspace 检查结果
+    python3 "$UTGEN_TILING_DATA_USAGE" "$WORKSPACE_REPORT_DIR/tiling_results.json" \
+        --json "$WORKSPACE_REPORT_DIR/tiling_data_usage.json" || true
+    
+    if [[ ! -f "$WORKSPACE_GOLDEN_FILE" ]]; then
+        log_warn "golden 文件不存在，用本次结果生成: $WORKSPACE_GOLDEN_FILE"
+        python3 "$UTGEN_WORKSPACE_GOLDEN" --golden "$WORKSPACE_GOLDEN_FILE" update \
+            "$WORKSPACE_REPORT_DIR/tiling_results.json"
+        return
+    fi
+    
+    if ! python3 "$UTGEN_WORKSPACE_GOLDEN" --golden "$WORKSPACE_GOLDEN_FILE" diff \
+        "$WORKSPACE_REPORT_DIR/tiling_results.json" --json "$WORKSPACE_REPORT_DIR/workspace_diff.json"; then
+        log_error "workspace 检查未通过，确认增长符合预期后执行:"
+        log_error "  python3 $UTGEN_WORKSPACE_GOLDEN --golden $WORKSPACE_GOLDEN_FILE update $WORKSPACE_REPORT_DIR/tiling_results.json"
+        exit 1
+    fi
+    
+    log_info "workspace 检查通过"
+}
+
+# tiling 结果快照：record 模式写出存储，verify 模式 mmap 存储后在用例中逐字节比对
+run_tiling_snapshot() {
+    local mode="$1"
+    log_info "tiling 结果快照 (${mode}): $TILING_STORE_FILE"
+    
+    cd "${OPS_TRANSFORMER_DIR}"
+    export BUILD_PATH="${OPS_TRANSFORMER_DIR}/build"
+    find_ut_binary
+    
+    if [[ "$mode" == "record" ]]; then
+        mkdir -p "$(dirname "$TILING_STORE_FILE")"
+        UTGEN_TILING_RECORD="$TILING_STORE_FILE" "$UT_BINARY" --gtest_filter='*Tiling*:-*InferShape*'
+        python3 "$UTGEN_TILING_STORE_TOOL" list "$TILING_STORE_FILE" | tail -1
+    else
+        if [[ ! -f "$TILING_STORE_FILE" ]]; then
+            log_error "快照文件不存在，请先使用 --tiling-snapshot record: $TILING_STORE_FILE"
+            exit 1
+        fi
+        UTGEN_TILING_VERIFY="$TILING_STORE_FILE" "$UT_BINARY" --gtest_filter='*Tiling*:-*InferShape*' || {
+            log_error "tiling 结果与快照不一致"
+            exit 1
+        }
+    fi
+    
+    log_info "tiling 结果快照 (${mode}) 完成"
+}
+
 # 显示帮助信息
 show_help() {
     echo "用法: $0 [选项]"
@@ -137,6 +278,10 @@ show_help() {
     echo "  --deploy-only    仅部署文件，不编译和测试"
     echo "  --build-only     仅部署和编译，不执行测试"
     echo "  --test-only      仅执行测试（假设文件已部署和编译）"
+    echo "  --perf-gate      测试通过后执行 tiling 性能门禁 (与历史基线比较耗时)"
+    echo "  --alloc-hook     链接堆分配 hook 库，统计每次 tiling 的分配并检查 JSONL 中的分配预算"
+    echo "  --workspace-check 测试通过后比对每个用例的 workspace / tiling data 长度与 golden，并输出 tiling data 利用率"
+    echo "  --tiling-snapshot record|verify  记录或逐字节校验每个用例完整的 tiling 结果"
     echo "  -h, --help       显示此帮助信息"
     echo ""
     echo "默认行为: 部署 -> 编译 -> 测试"
@@ -147,6 +292,10 @@ main() {
     local do_deploy=true
     local do_build=true
     local do_test=true
+    local do_perf_gate=false
+    local do_alloc_hook=false
+    local do_workspace_check=false
+    local snapshot_mode=""
     
     # 解析参数
     while [[ $# -gt 0 ]]; do
@@ -165,6 +314,26 @@ main() {
                 do_build=false
                 shift
                 ;;
+            --perf-gate)
+                do_perf_gate=true
+                shift
+                ;;
+            --alloc-hook)
+                do_alloc_hook=true
+                shift
+                ;;
+            --workspace-check)
+                do_workspace_check=true
+                shift
+                ;;
+            --tiling-snapshot)
+                if [[ "$2" != "record" && "$2" != "verify" ]]; then
+                    log_error "--tiling-snapshot 需要 record 或 verify"
+                    exit 1
+                fi
+                snapshot_mode="$2"
+                shift 2
+                ;;
             -h|--help)
                 show_help
                 exit 0
@@ -199,10 +368,26 @@ main() {
         build_ops
     fi
     
+    if $do_alloc_hook && ($do_build || $do_test); then
+        link_alloc_hook
+    fi
+    
     if $do_test; then
         run_tests
     fi
     
+    if $do_perf_gate; then
+        run_perf_gate
+    fi
+    
+    if $do_workspace_check; then
+        run_workspace_check
+    fi
+    
+    if [[ -n "$snapshot_mode" ]]; then
+        run_tiling_snapshot "$snapshot_mode"
+    fi
+    
     log_info "============================================"
     log_info "全部完成!"
     log_info "============================================"
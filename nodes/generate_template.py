@@ -145,10 +145,13 @@ def gen_mc2_matmul_like_code(op_class_name: str, inputs: List, outputs: List, at
     lines.append(' * See LICENSE in the root of the software repository for the full text of the License.')
     lines.append(' */')
     lines.append('')
-    lines.append('#include <iostream>')
     lines.append('#include <cctype>')
     lines.append('#include <gtest/gtest.h>')
     lines.append('#include "mc2_tiling_case_executor.h"')
+    lines.append('#include "utgen_log.h"')
+    lines.append('#include "utgen_tiling_probe.h"')
+    lines.append('#include "utgen_tiling_budget.h"')
+    lines.append('#include "utgen_tiling_capture.h"')
     lines.append('')
     lines.append(f'namespace {namespace_name} {{')
     lines.append('template <typename T>')
@@ -182,18 +185,20 @@ def gen_mc2_matmul_like_code(op_class_name: str, inputs: List, outputs: List, at
     lines.append('')
     lines.append('    // 结果')
     lines.append('    uint64_t expectTilingKey;')
+    lines.append('    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查')
+    lines.append('    UTGen::TilingBudget budget;')
     lines.append('};')
     lines.append('')
     lines.append(f'class {param_class_name} : public ::testing::TestWithParam<{struct_name}> {{')
     lines.append('protected:')
     lines.append('    static void SetUpTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling SetUp" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling SetUp";')
     lines.append('    }')
     lines.append('')
     lines.append('    static void TearDownTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling TearDown" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling TearDown";')
     lines.append('    }')
     lines.append('};')
     lines.append('')
@@ -245,7 +250,10 @@ def gen_mc2_matmul_like_code(op_class_name: str, inputs: List, outputs: List, at
         lines.append('        &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);')
 
     lines.append('')
+    lines.append(f'    UTGen::TilingProbe probe("{op_class_name}", param.case_name, param.expectTilingKey);')
     lines.append('    ExecuteTestCase(tilingContextPara, ge::GRAPH_SUCCESS, param.expectTilingKey);')
+    lines.append('    UTGen::CaptureTilingResult(probe, tilingContextPara);')
+    lines.append('    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara);')
     lines.append('}')
     lines.append('')
     lines.append(f'TEST_P({param_class_name}, general_case)')
@@ -328,11 +336,14 @@ def gen_all_gather_matmul_like_code(op_class_name: str, inputs: List, outputs: L
     lines.append(' * See LICENSE in the root of the software repository for the full text of the License.')
     lines.append(' */')
     lines.append('')
-    lines.append('#include <iostream>')
     lines.append('#include <thread>')
     lines.append('#include <cctype>')
     lines.append('#include <gtest/gtest.h>')
     lines.append('#include "mc2_tiling_case_executor.h"')
+    lines.append('#include "utgen_log.h"')
+    lines.append('#include "utgen_tiling_probe.h"')
+    lines.append('#include "utgen_tiling_budget.h"')
+    lines.append('#include "utgen_tiling_capture.h"')
     lines.append('')
     lines.append(f'namespace {namespace_name} {{')
     lines.append('')
@@ -371,18 +382,20 @@ def gen_all_gather_matmul_like_code(op_class_name: str, inputs: List, outputs: L
     lines.append('    // 结果')
     lines.append('    bool expectSuccess; // 是否期望 tiling 成功')
     lines.append('    uint64_t expectTilingKey;')
+    lines.append('    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查')
+    lines.append('    UTGen::TilingBudget budget;')
     lines.append('};')
     lines.append('')
     lines.append(f'class {param_class_name} : public ::testing::TestWithParam<{struct_name}> {{')
     lines.append('protected:')
     lines.append('    static void SetUpTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling SetUp" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling SetUp";')
     lines.append('    }')
     lines.append('')
     lines.append('    static void TearDownTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling TearDown" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling TearDown";')
     lines.append('    }')
     lines.append('};')
     lines.append('')
@@ -423,13 +436,17 @@ def gen_all_gather_matmul_like_code(op_class_name: str, inputs: List, outputs: L
     lines.append('        },')
     lines.append('        &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);')
     lines.append('')
+    lines.append(f'    UTGen::TilingProbe probe("{op_class_name}", param.case_name);')
     lines.append('    if (!param.expectSuccess) {')
     lines.append('        Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};')
     lines.append('        Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_FAILED, 0);')
     lines.append('    } else {')
     lines.append('        Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};')
+    lines.append('        probe.SetTilingKey(param.expectTilingKey);')
     lines.append('        Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);')
     lines.append('    }')
+    lines.append('    UTGen::CaptureTilingResult(probe, tilingContextPara, Mc2Hcom::MockValues{{"rankNum", 8}});')
+    lines.append('    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, Mc2Hcom::MockValues{{"rankNum", 8}});')
     lines.append('}')
     lines.append('')
     lines.append(f'TEST_P({param_class_name}, general_case)')
@@ -501,6 +518,8 @@ def gen_distribute_barrier_like_code(op_class_name: str, inputs: List, outputs:
     struct_fields.append("    std::string expectTilingData;")
     struct_fields.append("    std::vector<size_t> expectWorkspaces;")
     struct_fields.append("    uint64_t mc2TilingDataReservedLen;")
+    struct_fields.append("    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查")
+    struct_fields.append("    UTGen::TilingBudget budget;")
     struct_fields_code = "\n".join(struct_fields)
 
     lines = []
@@ -514,11 +533,14 @@ def gen_distribute_barrier_like_code(op_class_name: str, inputs: List, outputs:
     lines.append(' * See LICENSE in the root of the software repository for the full text of the License.')
     lines.append(' */')
     lines.append('')
-    lines.append('#include <iostream>')
     lines.append('#include <vector>')
     lines.append('#include <string>')
     lines.append('#include <gtest/gtest.h>')
     lines.append('#include "mc2_tiling_case_executor.h"')
+    lines.append('#include "utgen_log.h"')
+    lines.append('#include "utgen_tiling_probe.h"')
+    lines.append('#include "utgen_tiling_budget.h"')
+    lines.append('#include "utgen_tiling_capture.h"')
     lines.append('')
     lines.append('using namespace std;')
     lines.append('')
@@ -532,12 +554,12 @@ def gen_distribute_barrier_like_code(op_class_name: str, inputs: List, outputs:
     lines.append('protected:')
     lines.append('    static void SetUpTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling SetUp" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling SetUp";')
     lines.append('    }')
     lines.append('')
     lines.append('    static void TearDownTestCase()')
     lines.append('    {')
-    lines.append(f'        std::cout << "{op_class_name}Tiling TearDown" << std::endl;')
+    lines.append(f'        UTGEN_LOG(INFO) << "{op_class_name}Tiling TearDown";')
     lines.append('    }')
     lines.append('};')
     lines.append('')
@@ -550,9 +572,12 @@ def gen_distribute_barrier_like_code(op_class_name: str, inputs: List, outputs:
     lines.append(f'        {{{attr_code}}},')
     lines.append('        &compileInfo, param.soc_version, param.coreNum, param.ubSize);')
     lines.append('')
+    lines.append(f'    UTGen::TilingProbe probe("{op_class_name}", param.case_name, param.expectTilingKey);')
     lines.append('    Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};')
     lines.append('    Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey,')
     lines.append('        param.expectTilingData, param.expectWorkspaces, param.mc2TilingDataReservedLen);')
+    lines.append('    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);')
+    lines.append('    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);')
     lines.append('}')
     lines.append('')
     lines.append(f'TEST_P({param_class_name}, general_case)')
@@ -602,11 +627,14 @@ def gen_general_op_code(op_class_name: str, inputs: List, outputs: List, attrs:
     lines.append('/**')
     lines.append(' * Copyright (c) 2025 Huawei Technologies Co., Ltd. All rights reserved.')
     lines.append(' */')
-    lines.append('#include <iostream>')
     lines.append('#include <vector>')
     lines.append('#include <string>')
     lines.append('#include <gtest/gtest.h>')
     lines.append('#include "mc2_tiling_case_executor.h"')
+    lines.append('#include "utgen_log.h"')
+    lines.append('#include "utgen_tiling_probe.h"')
+    lines.append('#include "utgen_tiling_budget.h"')
+    lines.append('#include "utgen_tiling_capture.h"')
     lines.append('')
     lines.append(f'namespace {namespace_name} {{')
     lines.append('namespace {')
@@ -649,13 +677,15 @@ def gen_general_op_code(op_class_name: str, inputs: List, outputs: List, attrs:
             lines.append(f'    bool {attr_name};')
             
     lines.append('    uint64_t expectTilingKey;')
+    lines.append('    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查')
+    lines.append('    UTGen::TilingBudget budget;')
     lines.append('};')
     lines.append('')
 
     lines.append(f'class {param_class_name} : public ::testing::TestWithParam<{struct_name}> {{')
     lines.append('protected:')
-    lines.append('    static void SetUpTestCase() { std::cout << "SetUp" << std::endl; }')
-    lines.append('    static void TearDownTestCase() { std::cout << "TearDown" << std::endl; }')
+    lines.append('    static void SetUpTestCase() { UTGEN_LOG(INFO) << "SetUp"; }')
+    lines.append('    static void TearDownTestCase() { UTGEN_LOG(INFO) << "TearDown"; }')
     lines.append('};')
     lines.append('')
 
@@ -682,8 +712,11 @@ def gen_general_op_code(op_class_name: str, inputs: List, outputs: List, attrs:
     lines.append('        },')
     lines.append('        &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);')
     lines.append('')
+    lines.append(f'    UTGen::TilingProbe probe("{op_class_name}", param.case_name, param.expectTilingKey);')
     lines.append('    Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};')
     lines.append('    Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);')
+    lines.append('    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);')
+    lines.append('    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);')
     lines.append('}')
     lines.append('')
 
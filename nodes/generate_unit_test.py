@@ -8,10 +8,12 @@
 """
 import json
 import re
+import sys
 from pathlib import Path
-from typing import Any, Dict, List, Tuple
+from typing import Any, Callable, Dict, List, Optional, Tuple
 
 from state import WorkflowState
+from utils.convert_cases_params import parse_add_rms_norm_case_name
 
 
 # AllGatherMatmul / MatmulAllReduce 使用的字段顺序
@@ -110,14 +112,19 @@ def detect_mode(template_content: str, struct_name: str) -> str:
     """
     根据结构体名称和模板特征检测生成模式。
     返回: 'moe_tensor_desc' | 'all_gather_matmul_v2' | 'all_gather_matmul' | 'matmul_all_reduce' | 'distribute_barrier' | 'allto_allv_complex'
+          | 'matmul_all_reduce_add_rms_norm'
     """
     # 检查是否是使用 vector<TensorDescription> 的复杂模式
     if "std::vector<gert::TilingContextPara::TensorDescription> inputs;" in template_content:
         return "moe_tensor_desc"
     
-    # 检查是否是 allto_allv_grouped_mat_mul 的特殊结构 (有 tiling_params_str_pair 字段)
-    if "std::vector<std::pair<string, string>> tiling_params_str_pair" in template_content:
+    # 检查是否是 allto_allv_grouped_mat_mul 的特殊结构 (TestParam 内嵌物化的 TilingParams)
+    if "TilingParams tiling_params{};" in template_content:
         return "allto_allv_complex"
+
+    # 检查是否是 matmul_all_reduce_add_rms_norm 的类型化结构 (预计算 shape 的 TestParam)
+    if "std::initializer_list<int64_t> antiquantScaleOriginShape;" in template_content:
+        return "matmul_all_reduce_add_rms_norm"
     
     # 优先根据结构体名称判断特殊类型
     if "AllGatherMatmul" in struct_name:
@@ -155,6 +162,79 @@ def read_jsonl(file_path: Path) -> List[Dict[str, Any]]:
     return cases
 
 
+# 算子级默认值记录: {"defaults": {"maxTilingLatencyUs": 500}}，可放在 JSONL 的任意位置
+DEFAULTS_RECORD_KEY = "defaults"
+# 可在默认值记录中统一指定、用例未写时补齐的用例字段 (同一算子的用例共用一套硬件参数)
+CASE_DEFAULT_FIELDS = ("soc_version", "coreNum", "ubSize")
+# 参数结构体中 tiling 预算成员的类型，由生成器单独渲染
+TILING_BUDGET_TYPE = "UTGen::TilingBudget"
+# JSONL 字段 -> TilingBudget 成员类型
+TILING_BUDGET_FIELDS = {
+    "maxTilingLatencyUs": "double",
+    "maxTilingAllocs": "uint64_t",
+    "maxTilingAllocBytes": "uint64_t",
+}
+
+
+def split_case_defaults(records: List[Dict[str, Any]]) -> Tuple[List[Dict[str, Any]], Dict[str, Any]]:
+    """从 JSONL 记录中分离出算子级默认值记录，返回 (用例列表, 默认值)"""
+    cases = []
+    defaults: Dict[str, Any] = {}
+    for record in records:
+        if set(record) == {DEFAULTS_RECORD_KEY}:
+            defaults.update(record[DEFAULTS_RECORD_KEY])
+        else:
+            cases.append(record)
+    return cases, defaults
+
+
+def apply_case_defaults(cases: List[Dict[str, Any]], defaults: Dict[str, Any]) -> List[Dict[str, Any]]:
+    """把默认值记录中的 CASE_DEFAULT_FIELDS 补到未指定这些字段的用例上，用例自身的取值优先"""
+    fills = {key: defaults[key] for key in CASE_DEFAULT_FIELDS if key in defaults}
+    if not fills:
+        return cases
+    return [{**case, **{key: value for key, value in fills.items() if key not in case}} for case in cases]
+
+
+def generate_budget_cpp(case: Dict[str, Any], defaults: Dict[str, Any]) -> str:
+    """
+    用例级预算优先于算子级默认值，都未指定时返回空串 (沿用结构体默认值，不检查)。
+    按 TilingBudget 的声明顺序位置初始化 (C++17)，最后一个指定字段之前未指定的字段写 0 (不限制)。
+    """
+    values = []
+    case_name = case.get("case_name", case.get("test_name", ""))
+    for field, cpp_type in TILING_BUDGET_FIELDS.items():
+        value = case.get(field, defaults.get(field))
+        if value is None:
+            values.append(None)
+            continue
+        if not isinstance(value, (int, float)) or isinstance(value, bool) or value < 0:
+            raise ValueError(f"{case_name}: {field} 必须是非负数值，实际为 {value!r}")
+        if cpp_type == "double":
+            values.append(repr(float(value)))
+        else:
+            values.append(checked_int_cpp(value, cpp_type, f"{case_name}.{field}"))
+    while values and values[-1] is None:
+        values.pop()
+    return "{" + ", ".join(v if v is not None else "0" for v in values) + "}" if values else ""
+
+
+def append_case_member(case_code: str, member: str) -> str:
+    """在用例初始化列表的结束花括号前追加一个成员初始化，保持原有的单行/多行排版"""
+    close = case_code.rindex("}")
+    body = case_code[:close].rstrip(" ")
+    tail = case_code[close:]
+    last_line = body.rstrip("\n").split("\n")[-1]
+    indent = re.match(r"\s*", last_line).group(0)
+    if body.endswith("\n"):
+        # 结束花括号单独成行 (moe_tensor_desc)
+        return body.rstrip("\n") + ",\n" + indent + member + "\n" + case_code[len(body):close] + tail
+    if member.startswith(".") and "\n" in body:
+        # 指定初始化器每个成员一行 (allto_allv)
+        return body + ",\n" + indent + member + tail
+    return body + ", " + member + tail
+
+
 def format_int(value: int, key: str = "") -> str:
     """格式化整数，对于 expectTilingKey 加 UL 后缀，对于大数使用十六进制"""
     if key == "expectTilingKey":
@@ -187,6 +267,9 @@ def convert_value_to_cpp(key: str, value: Any, use_compile_info: bool = False) -
             return clean_ge_type_string(value)
         if key in ("compile_info", "expectTilingData") and use_compile_info:
             return "COMPILE_INFO"
+        if key == "compile_info":
+            # 与公共 COMPILE_INFO 不同的 JSON (如按硬件 profile 展开的用例) 含引号，以原始字符串内联
+            return f'R"({value})"'
         return f'"{value}"'
     elif isinstance(value, list):
         if len(value) == 0:
@@ -498,32 +581,77 @@ COMMON_FIELD_MAPPING = {
 }
 
 
-def parse_struct_fields(template_content: str, struct_name: str) -> List[Tuple[str, str]]:
-    """
-    解析结构体定义，返回 [(字段名, 类型), ...]列表。
-    """
-    # 找到结构体定义的开始
+def extract_struct_body(template_content: str, struct_name: str) -> str:
+    """按花括号配对提取结构体定义体，兼容带 {...} 默认初始化的成员"""
     start_pattern = f"struct {struct_name} {{"
     start_idx = template_content.find(start_pattern)
     if start_idx == -1:
+        return ""
+
+    body_start = start_idx + len(start_pattern)
+    depth = 1
+    for idx in range(body_start, len(template_content)):
+        ch = template_content[idx]
+        if ch == "{":
+            depth += 1
+        elif ch == "}":
+            depth -= 1
+            if depth == 0:
+                return template_content[body_start:idx]
+    return ""
+
+
+def split_struct_declarations(template_content: str, struct_name: str) -> List[str]:
+    """去掉行注释后按顶层分号切分结构体的成员声明"""
+    struct_body = extract_struct_body(template_content, struct_name)
+    if not struct_body:
         return []
-    
-    # 找到结构体定义的结束
-    end_idx = template_content.find("};", start_idx)
-    if end_idx == -1:
-        return []
-        
-    struct_body = template_content[start_idx + len(start_pattern):end_idx]
-    
+
+    code = "\n".join(line.split("//")[0] for line in struct_body.split("\n"))
+    declarations = []
+    depth = 0
+    current = []
+    for ch in code:
+        if ch in "{(<":
+            depth += 1
+        elif ch in "})>":
+            depth -= 1
+        if ch == ";" and depth == 0:
+            declarations.append("".join(current))
+            current = []
+        else:
+            current.append(ch)
+    return declarations
+
+
+def parse_struct_defaults(template_content: str, struct_name: str) -> Dict[str, str]:
+    """
+    解析结构体成员的默认初始化，返回 {字段名: C++ 初始化表达式}。
+    {...} 形式原样保留花括号，= ... 形式取等号右侧；没有默认初始化的字段不出现在结果中。
+    """
+    defaults = {}
+    for decl in split_struct_declarations(template_content, struct_name):
+        code = " ".join(decl.split())
+        match = re.match(r"^[\w:<>,\s]*?(\w+)\s*(?:=\s*(.+)|(\{.*\}))$", code)
+        if match:
+            defaults[match.group(1)] = match.group(2) or match.group(3)
+    return defaults
+
+
+def parse_struct_fields(template_content: str, struct_name: str) -> List[Tuple[str, str]]:
+    """
+    解析结构体定义，返回 [(字段名, 类型), ...]列表。
+    成员可以跨行，也可以带 {...} 或 = ... 形式的默认初始化。
+    """
     fields = []
-    # 逐行解析
-    for line in struct_body.split('\n'):
-        line = line.strip()
-        if not line or line.startswith('//'):
-            continue
-            
-        # 移除分号及之后的内容
-        code_part = line.split(';')[0].strip()
+    for decl in split_struct_declarations(template_content, struct_name):
+        # 移除默认初始化部分
+        code_part = " ".join(decl.split())
+        code_part = re.split(r"\s*=\s*", code_part, maxsplit=1)[0]
+        brace_idx = code_part.find("{")
+        if brace_idx != -1:
+            code_part = code_part[:brace_idx]
+        code_part = code_part.strip()
         if not code_part:
             continue
 
@@ -535,7 +663,7 @@ def parse_struct_fields(template_content: str, struct_name: str) -> List[Tuple[s
             # 清理可能的指针或引用符号 (虽然在结构体成员中不常见，但以防万一)
             field_name = field_name.replace('*', '').replace('&', '')
             fields.append((field_name, field_type))
-            
+
     return fields
 
 
@@ -581,76 +709,276 @@ def generate_generic_case(case: Dict[str, Any], fields: List[Tuple[str, str]], c
     return "    {" + ", ".join(values) + "},"
 
 
-def generate_simple_test_param_case(case: Dict[str, Any], struct_name: str) -> str:
+# legacy caseName 中的 dtype 缩写 -> ge::DataType，未知缩写与原 std::map 查找行为一致退化为 DT_FLOAT
+ADD_RMS_NORM_DTYPE_MAP = {
+    "FLOAT16": "ge::DT_FLOAT16",
+    "FLOAT": "ge::DT_FLOAT",
+    "BF16": "ge::DT_BF16",
+    "INT8": "ge::DT_INT8",
+    "INT4": "ge::DT_INT4",
+    "UINT64": "ge::DT_UINT64",
+    "INT32": "ge::DT_INT32",
+}
+
+
+def format_shape_cpp(shape: List[int]) -> str:
+    """将 shape 列表格式化为 C++ initializer_list"""
+    return "{" + ", ".join(str(v) for v in shape) + "}"
+
+
+def compute_add_rms_norm_shapes(params: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    根据用例参数预先计算 MatmulAllReduceAddRmsNorm 各输入的 shape 和 dtype，
+    与原模板中运行时的 shape 推导逻辑保持一致。
+    """
+    m, k, n = params["m"], params["k"], params["n"]
+    trans_a, trans_b = params["transA"], params["transB"]
+    group = params["group"]
+    y_dtype = ADD_RMS_NORM_DTYPE_MAP.get(params["yDtype"], "ge::DT_FLOAT")
+    quant_dtype = y_dtype
+
+    x_shape = [k, m] if trans_a else [m, k]
+    weight_shape = [n, k] if trans_b else [k, n]
+    quant_scale_shape: List[int] = []
+    if group > 0:
+        group_num = (k + group - 1) // group
+        if trans_b:
+            antiquant_offset_shape = [n, group_num]
+            antiquant_scale_storage, antiquant_scale_origin = [n, group_num], [m, group_num]
+        else:
+            antiquant_offset_shape = [group_num, n]
+            antiquant_scale_storage = antiquant_scale_origin = [group_num, n]
+    else:
+        dim = [n] if group < 0 else [1]
+        antiquant_offset_shape = dim
+        antiquant_scale_storage = antiquant_scale_origin = dim
+        quant_scale_shape = dim
+        if y_dtype != "ge::DT_BF16":
+            quant_dtype = "ge::DT_UINT64"
+
+    if not params["antiquant_offsetExistFlag"]:
+        antiquant_offset_shape = []
+    if not params["antiquant_scaleExistFlag"]:
+        antiquant_scale_storage = antiquant_scale_origin = []
+    if not params["dequant_scaleExistFlag"]:
+        quant_scale_shape = []
+
+    return {
+        "xShape": x_shape,
+        "weightShape": weight_shape,
+        "biasShape": [n] if params["biasFlag"] else [],
+        "yShape": [1, m, n],
+        "gammaShape": [n],
+        "antiquantOffsetShape": antiquant_offset_shape,
+        "antiquantScaleStorageShape": antiquant_scale_storage,
+        "antiquantScaleOriginShape": antiquant_scale_origin,
+        "quantScaleShape": quant_scale_shape,
+        "xDtype": ADD_RMS_NORM_DTYPE_MAP.get(params["xDtype"], "ge::DT_FLOAT"),
+        "weightDtype": ADD_RMS_NORM_DTYPE_MAP.get(params["weightDtype"], "ge::DT_FLOAT"),
+        "biasDtype": ADD_RMS_NORM_DTYPE_MAP.get(params["biasDtype"], "ge::DT_FLOAT"),
+        "yDtype": y_dtype,
+        "quantScaleDtype": quant_dtype,
+    }
+
+
+def generate_add_rms_norm_case(case: Dict[str, Any]) -> str:
     """
-    生成简单的 TestParam 用例（只有 caseName, blockDim, tilingKey）。
-    用于 matmul_all_reduce_add_rms_norm 等特殊模板。
+    生成 matmul_all_reduce_add_rms_norm 的类型化 TestParam 用例。
+    JSONL 中缺少解码字段时（只有 case_name/blockDim/tilingKey 的旧数据），
+    通过 parse_add_rms_norm_case_name 从 legacy caseName 中还原参数。
     """
     case_name = case.get("case_name", "")
+    params = parse_add_rms_norm_case_name(case_name)
+    params.update({k: v for k, v in case.items() if k != "case_name"})
+    if "m" not in params:
+        raise ValueError(f"无法解析 MatmulAllReduceAddRmsNorm 用例参数: {case_name}")
+
+    shapes = compute_add_rms_norm_shapes(params)
     block_dim = case.get("blockDim", 8)
     tiling_key = case.get("tilingKey", 0)
-    
-    # 处理大整数，使用 UL 后缀
-    if tiling_key > 65535:
-        tiling_key_str = f"{tiling_key}"
-    else:
-        tiling_key_str = str(tiling_key)
-    
-    return f'        {{"{case_name}", {block_dim}, {tiling_key_str}}},'
+    is_invalid = "InValid" in params.get("model_name", "")
+    missing = [key for key in CASE_DEFAULT_FIELDS if key not in case]
+    if missing:
+        raise ValueError(f"MatmulAllReduceAddRmsNorm 用例 {case_name} 缺少硬件字段: {', '.join(missing)} "
+                         f"(可在 JSONL 的 {DEFAULTS_RECORD_KEY} 记录中统一指定)")
+    soc_version, core_num, ub_size = (case[key] for key in CASE_DEFAULT_FIELDS)
+
+    line1 = f'        {{"{case_name}", {block_dim}, {tiling_key}, "{soc_version}", {core_num}, {ub_size},'
+    line2 = (f'            {"true" if is_invalid else "false"}, "{params["group_name"]}", "{params["reduce_op"]}", '
+             f'{"true" if params["transA"] else "false"}, {"true" if params["transB"] else "false"}, '
+             f'{params["antigroupSize"]}, {float(params["epsilon"])!r}f,')
+    shape_keys = ["xShape", "weightShape", "biasShape", "yShape", "gammaShape", "antiquantOffsetShape",
+                  "antiquantScaleStorageShape", "antiquantScaleOriginShape", "quantScaleShape"]
+    line3 = "            " + ", ".join(format_shape_cpp(shapes[key]) for key in shape_keys) + ","
+    dtype_keys = ["xDtype", "weightDtype", "biasDtype", "yDtype", "quantScaleDtype"]
+    line4 = "            " + ", ".join(shapes[key] for key in dtype_keys) + "},"
+    return "\n".join([line1, line2, line3, line4])
+
 
+# allto_allv 用例中显式指定任一 key 时，mm 相关 shape 不会被清空
+ALLTO_ALLV_MM_KEYS = ("BS", "H2", "mm_weight_dim0", "N2")
+
+# C++ 整数类型的取值范围，用于生成阶段的溢出校验
+CPP_INT_RANGES = {
+    "uint64_t": (0, 2**64 - 1),
+    "int64_t": (-2**63, 2**63 - 1),
+    "uint32_t": (0, 2**32 - 1),
+    "int32_t": (-2**31, 2**31 - 1),
+}
 
-def generate_allto_allv_complex_case(case: Dict[str, Any]) -> str:
+
+def checked_int_cpp(value: Any, cpp_type: str, where: str) -> str:
+    """将数值转换为 C++ 字面量，超出 cpp_type 取值范围时在生成阶段报错"""
+    try:
+        int_value = int(str(value), 0)
+    except ValueError:
+        raise ValueError(f"{where}: '{value}' 不是合法的整数")
+    low, high = CPP_INT_RANGES[cpp_type]
+    if not low <= int_value <= high:
+        raise ValueError(f"{where}: {int_value} 超出 {cpp_type} 取值范围 [{low}, {high}]")
+    if int_value > CPP_INT_RANGES["int64_t"][1]:
+        return f"{int_value}ULL"
+    return str(int_value)
+
+
+def materialize_tiling_param_value(value: Any, cpp_type: str, where: str) -> str:
+    """根据 TilingParams 字段类型把 JSONL 中的值物化为 C++ 初始化表达式"""
+    if cpp_type == "bool":
+        text = str(value).lower()
+        if text not in ("true", "false"):
+            raise ValueError(f"{where}: '{value}' 不是合法的 bool 值")
+        return text
+    if cpp_type in CPP_INT_RANGES:
+        return checked_int_cpp(value, cpp_type, where)
+    if "string" in cpp_type:
+        return f'"{value}"'
+    vec_match = re.match(r"std::vector<(\w+)>", cpp_type)
+    if vec_match and vec_match.group(1) in CPP_INT_RANGES:
+        items = ", ".join(checked_int_cpp(v, vec_match.group(1), f"{where}[{i}]") for i, v in enumerate(value))
+        return "{" + items + "}"
+    raise ValueError(f"{where}: 不支持的 TilingParams 字段类型 {cpp_type}")
+
+
+def generate_allto_allv_complex_case(case: Dict[str, Any], tiling_fields: List[Tuple[str, str]],
+                                     tiling_defaults: Dict[str, str]) -> str:
     """
-    生成 allto_allv_grouped_mat_mul 的复杂 TestParam 用例。
-    格式: {"test_name", {{pairs...}}, {{vec_pairs...}}, {{dtype_pairs...}}, status}
+    生成 allto_allv_grouped_mat_mul 的 TestParam 用例。
+
+    JSONL 中的 tiling_params_str_pair / tiling_params_vec_pair 在生成阶段解析并按
+    TilingParams 的声明顺序物化为位置聚合初始化（与其它生成器一致，保持 C++17 可编译）：
+    最后一个指定字段之前未指定的字段写出结构体中的默认值，之后的字段沿用结构体默认值；
+    数值越界、未知字段都会直接报错，运行时不再做字符串解析。
+    tiling_dTypes_pair 在原运行时逻辑中未被使用，这里同样忽略。
+    格式: {"...", {4096, 2048, ..., 64}, false, ge::GRAPH_FAILED}
     """
     test_name = case.get("test_name", "")
     status = case.get("status", "ge::GRAPH_FAILED")
-    
-    # 处理 tiling_params_str_pair: [{"key": "e", "value": "64"}, ...]
-    str_pairs = case.get("tiling_params_str_pair", [])
-    if str_pairs:
-        pairs_str = ", ".join(f'{{"{p.get("key", "")}", "{p.get("value", "")}"}}' for p in str_pairs)
-        str_pair_cpp = "{" + pairs_str + "}"
-    else:
-        str_pair_cpp = "{}"
-    
-    # 处理 tiling_params_vec_pair: [{"key": "send_counts", "value": [...]}, ...]
-    vec_pairs = case.get("tiling_params_vec_pair", [])
-    if vec_pairs:
-        vec_parts = []
-        for p in vec_pairs:
-            key = p.get("key", "")
-            values = p.get("value", [])
-            if values:
-                vec_str = ", ".join(str(v) for v in values)
-                vec_parts.append(f'{{"{key}", {{{vec_str}}}}}')
-            else:
-                vec_parts.append(f'{{"{key}", {{}}}}')
-        vec_pair_cpp = "{" + ", ".join(vec_parts) + "}"
-    else:
-        vec_pair_cpp = "{}"
-    
-    # 处理 tiling_dTypes_pair: [{"idx": 0, "dtype": "ge::DT_FLOAT16"}, ...]
-    dtype_pairs = case.get("tiling_dTypes_pair", [])
-    if dtype_pairs:
-        dtype_parts = []
-        for p in dtype_pairs:
-            idx = p.get("idx", 0)
-            dtype = p.get("dtype", "ge::DT_FLOAT16")
-            dtype_parts.append(f'{{{idx}, {dtype}}}')
-        dtype_pair_cpp = "{" + ", ".join(dtype_parts) + "}"
-    else:
-        dtype_pair_cpp = "{}"
-    
-    return f'    {{"{test_name}", {str_pair_cpp}, {vec_pair_cpp}, {dtype_pair_cpp}, {status}}},'
+    field_types = dict(tiling_fields)
+
+    # 同一个 key 出现多次时以最后一次为准，与原 handler 依次执行的效果一致
+    overrides: Dict[str, Any] = {}
+    for pair in case.get("tiling_params_str_pair", []) + case.get("tiling_params_vec_pair", []):
+        key = pair.get("key", "")
+        if key not in field_types:
+            raise ValueError(f"{test_name}: TilingParams 中不存在字段 '{key}'")
+        overrides[key] = pair.get("value")
+
+    names = [name for name, _ in tiling_fields]
+    last = max((names.index(key) for key in overrides), default=-1)
+    values = []
+    for name, cpp_type in tiling_fields[:last + 1]:
+        if name in overrides:
+            values.append(materialize_tiling_param_value(overrides[name], cpp_type, f"{test_name}.{name}"))
+        else:
+            # 没有默认初始化的字段按值初始化；标量的 {x} 默认值去掉花括号
+            default = tiling_defaults.get(name, "{}")
+            if default.startswith("{") and "vector" not in cpp_type and default[1:-1].strip():
+                default = default[1:-1].strip()
+            values.append(default)
+    tiling_params_cpp = "{" + ", ".join(values) + "}"
+    has_mm_keys = any(key in overrides for key in ALLTO_ALLV_MM_KEYS)
+
+    return "\n".join([
+        f'    {{"{test_name}",',
+        f'     {tiling_params_cpp},',
+        f'     {"true" if has_mm_keys else "false"},',
+        f'     {status}}},',
+    ])
+
+
+def add_utils_path() -> None:
+    """utils/ 下的性能模型与登记表读取以脚本方式互相导入，按需加入搜索路径"""
+    utils_dir = str(Path(__file__).resolve().parent.parent / "utils")
+    if utils_dir not in sys.path:
+        sys.path.insert(0, utils_dir)
+
+
+def load_comm_annotator(op_name: str) -> Callable[[Dict[str, Any]], Optional[str]]:
+    add_utils_path()
+    from comm_volume import CaseAnnotator
+    return CaseAnnotator(op_name)
+
+
+# 模板从用例参数读取 socVersion (或 compile_info) 时才能按硬件 profile 展开
+HARDWARE_PARAM_RE = re.compile(r'\bparam\.(?:soc_version|socVersion|compile_info)\b')
+
+
+def expand_soc_profiles(cases: List[Dict[str, Any]], profile_names: str, template_content: str,
+                        op_name: str) -> List[Dict[str, Any]]:
+    """每个用例按 registry/hardware_profiles.yaml 中选定的 profile 各展开一份，用例名加 _<profile> 后缀"""
+    add_utils_path()
+    from hardware_profiles import expand_cases, select_profiles
+    profiles = select_profiles(profile_names)
+    if not HARDWARE_PARAM_RE.search(template_content):
+        print(f"警告: {op_name} 的模板中硬件参数为常量，不按硬件 profile 展开")
+        return cases
+    return expand_cases(cases, profiles)
+
+
+def generate_record_only_cpp(cases: List[Dict[str, Any]]) -> str:
+    """登记按非原 SoC profile 展开的用例 (见 utgen_tiling_exec.h 的 RecordOnlyCases)，没有这类用例时返回空串"""
+    add_utils_path()
+    from hardware_profiles import CASE_NAME_FIELDS, RECORD_ONLY_FIELD
+    names = [next(case[f] for f in CASE_NAME_FIELDS if f in case) for case in cases if case.get(RECORD_ONLY_FIELD)]
+    if not names:
+        return ""
+    lines = ["// 按非原 SoC 的硬件 profile 展开的用例没有该硬件上的期望值，只执行 tiling 并由 CaptureTilingResult 记录结果",
+             "const bool g_recordOnlyCasesRegistered = UTGen::RecordOnlyCases::Instance().Register({"]
+    lines += [f'    "{name}",' for name in names]
+    lines.append("});")
+    return "\n".join(lines)
+
+
+def route_record_only_cases(content: str) -> str:
+    """断言调用先检查用例是否只记录结果；探针 probe 在各模板中都先于断言调用构造"""
+    content = re.sub(r'(?<![\w:])Mc2ExecuteTestCase\(', 'UTGen::ProfileMc2ExecuteTestCase(probe.CaseName(), ', content)
+    return re.sub(r'(?<![\w:])ExecuteTestCase\(', 'UTGen::ProfileExecuteTestCase(probe.CaseName(), ', content)
+
+
+def prepend_case_comment(case_code: str, text: str) -> str:
+    """在用例前插入一行与用例首行同缩进的注释"""
+    indent = re.match(r"\s*", case_code).group(0).lstrip("\n")
+    return f"{indent}// {text}\n{case_code}"
 
 
 def generate_cases_params(mode: str, cases: List[Dict[str, Any]], 
                           struct_name: str, common_value: str,
-                          template_content: str = "") -> str:
-    """生成 cases_params 数组代码"""
+                          template_content: str = "", defaults: Optional[Dict[str, Any]] = None,
+                          annotate: Optional[Callable[[Dict[str, Any]], Optional[str]]] = None) -> str:
+    """生成 cases_params 数组代码；annotate 返回的文本作为注释写在对应用例之前"""
     lines = []
+    defaults = defaults or {}
+
+    def finish_case(case_code: str, case: Dict[str, Any]) -> str:
+        note = annotate(case) if annotate else None
+        if note:
+            case_code = prepend_case_comment(case_code, note)
+        budget_cpp = generate_budget_cpp(case, defaults)
+        if not budget_cpp:
+            return case_code
+        if TILING_BUDGET_TYPE not in template_content:
+            raise ValueError(f"模板结构体 {struct_name} 中没有 {TILING_BUDGET_TYPE} 成员，无法渲染耗时预算")
+        return append_case_member(case_code, budget_cpp)
     
     # 从模板中提取参数数组名称
     param_array_names = extract_param_array_names(template_content)
@@ -678,7 +1006,7 @@ def generate_cases_params(mode: str, cases: List[Dict[str, Any]],
         for array_name, array_cases in [(valid_array, valid_cases), (invalid_array, invalid_cases)]:
             result_lines.append(f"static {struct_name} {array_name}[] = {{")
             for case in array_cases:
-                case_code = generate_simple_test_param_case(case, struct_name)
+                case_code = finish_case(generate_add_rms_norm_case(case), case)
                 result_lines.append(case_code)
             result_lines.append("")
             result_lines.append("};")
@@ -694,45 +1022,311 @@ def generate_cases_params(mode: str, cases: List[Dict[str, Any]],
     lines.append(f"{struct_name} {param_array_name}[] = {{")
     
     # 尝试解析结构体字段以使用通用生成逻辑
-    struct_fields = parse_struct_fields(template_content, struct_name)
+    struct_fields = [field for field in parse_struct_fields(template_content, struct_name)
+                     if field[1] != TILING_BUDGET_TYPE]
     
     for i, case in enumerate(cases):
         if mode == "moe_tensor_desc":
             # 复杂的 TensorDescription 模式
             case_code = generate_moe_tensor_desc_case(case)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
         elif mode == "allto_allv_complex":
             # allto_allv_grouped_mat_mul 的复杂结构
-            case_code = generate_allto_allv_complex_case(case)
-            lines.append(case_code)
+            case_code = generate_allto_allv_complex_case(case, parse_struct_fields(template_content, "TilingParams"),
+                                                         parse_struct_defaults(template_content, "TilingParams"))
+            lines.append(finish_case(case_code, case))
         elif mode == "all_gather_matmul_v2":
             # AllGatherMatmul V2 (带 expectSuccess)
             case_code = generate_all_gather_matmul_case(case, common_value, include_expect_success=True)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
             if i < len(cases) - 1:
                 lines.append("")
         elif mode == "all_gather_matmul":
             # AllGatherMatmul V1 (不带 expectSuccess)
             case_code = generate_all_gather_matmul_case(case, common_value, include_expect_success=False)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
             if i < len(cases) - 1:
                 lines.append("")
         elif struct_fields:
             # 如果成功解析了结构体字段，使用通用生成逻辑
             case_code = generate_generic_case(case, struct_fields, common_value, struct_name)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
         elif mode == "matmul_all_reduce":
             # 降级到旧的 matmul 逻辑
             case_code = generate_matmul_all_reduce_case(case, common_value)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
         else:  # distribute_barrier (legacy)
             case_code = generate_distribute_barrier_case(case, common_value)
-            lines.append(case_code)
+            lines.append(finish_case(case_code, case))
     
     lines.append("};")
     return "\n".join(lines)
 
 
+# ============== 批量执行模式 ==============
+# 批量模式下用一个 TEST 遍历全部用例表，只做一次 gtest 注册与 SetUp/TearDown，
+# 每个用例的失败通过 ScopedFakeTestPartResultReporter 截获后汇总成一份报告。
+BATCHED_RUNNER_TEMPLATE = """template <typename Param, size_t N>
+void RunBatchedCases(const char *tableName, const Param (&cases)[N], size_t &caseCount,
+                     std::vector<std::string> &failureReport)
+{{
+    for (const auto &param : cases) {{
+        ++caseCount;
+        ::testing::TestPartResultArray caseResults;
+        {{
+            ::testing::ScopedFakeTestPartResultReporter reporter(
+                ::testing::ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD, &caseResults);
+{case_body}
+        }}
+        for (int i = 0; i < caseResults.size(); ++i) {{
+            const ::testing::TestPartResult &result = caseResults.GetTestPartResult(i);
+            if (!result.failed()) {{
+                continue;
+            }}
+            std::ostringstream entry;
+            entry << "[" << tableName << "] " << param.{name_field} << " ("
+                  << (result.file_name() == nullptr ? "unknown" : result.file_name()) << ":"
+                  << result.line_number() << ")\\n    " << result.summary();
+            failureReport.push_back(entry.str());
+        }}
+    }}
+}}
+
+std::string FormatBatchedReport(size_t caseCount, const std::vector<std::string> &failureReport)
+{{
+    std::ostringstream report;
+    report << "BatchedTilingReport: " << failureReport.size() << " failure(s) in " << caseCount << " case(s)";
+    for (const auto &entry : failureReport) {{
+        report << "\\n  " << entry;
+    }}
+    return report.str();
+}}
+
+"""
+
+BATCHED_TEST_TEMPLATE = """TEST_F({suite}, {test_name}_batched)
+{{
+{setup}    size_t caseCount = 0;
+    std::vector<std::string> failureReport;
+    {{
+        // 整批用例共用拓扑 mock：相同的 mock 值只设置一次，批次结束时复位一次
+        UTGen::HcomMockBatch hcomMockBatch;
+{run_tables}
+    }}
+{teardown}    if (!failureReport.empty()) {{
+        ADD_FAILURE() << FormatBatchedReport(caseCount, failureReport);
+    }}
+}}
+"""
+
+# 用例库模式：不向 gtest 注册任何用例，而是导出 C 接口供常驻 runner dlopen 后调用
+CASE_LIBRARY_RUN_TEMPLATE = """int RunCaseLibrary(UTGenCaseLibraryResult *result)
+{{
+    // 报告文本在库被卸载前保持有效，runner 在重新加载前完成输出
+    static std::string report;
+{setup}    size_t caseCount = 0;
+    std::vector<std::string> failureReport;
+    {{
+        UTGen::HcomMockBatch hcomMockBatch;
+{run_tables}
+    }}
+{teardown}    report = FormatBatchedReport(caseCount, failureReport);
+    result->caseCount = caseCount;
+    result->failureCount = failureReport.size();
+    result->report = report.c_str();
+    return failureReport.empty() ? 0 : 1;
+}}
+"""
+
+CASE_LIBRARY_ENTRY_TEMPLATE = """
+extern "C" UTGEN_CASE_LIBRARY_EXPORT int UTGenRunCaseLibrary(UTGenCaseLibraryResult *result)
+{{
+    return {qualifier}RunCaseLibrary(result);
+}}
+"""
+
+
+def extract_test_p_block(content: str) -> Tuple[int, int, str, str, str]:
+    """
+    定位 TEST_P 定义，返回 (起始位置, 结束位置, fixture 名, 测试名, 函数体)。
+    找不到时抛出 ValueError。
+    """
+    match = re.search(r'TEST_P\(\s*(\w+)\s*,\s*(\w+)\s*\)\s*\{', content)
+    if not match:
+        raise ValueError("模板中未找到 TEST_P 定义")
+    depth = 1
+    idx = match.end()
+    while idx < len(content) and depth > 0:
+        if content[idx] == "{":
+            depth += 1
+        elif content[idx] == "}":
+            depth -= 1
+        idx += 1
+    return match.start(), idx, match.group(1), match.group(2), content[match.end():idx - 1]
+
+
+def split_test_p_body(body: str) -> Tuple[List[str], List[str], List[str]]:
+    """
+    将 TEST_P 函数体拆成 (用例前准备, 单个用例执行, 用例后清理) 三段代码行。
+    以 GetParam() 所在行为界：之前的是准备代码，之后直到 TestOneParamCase 调用为用例执行，
+    其余为清理代码。
+    """
+    setup, case_body, teardown = [], [], []
+    section = setup
+    for line in body.strip("\n").split("\n"):
+        if "GetParam()" in line:
+            section = case_body
+            continue
+        section.append(line)
+        if section is case_body and "TestOneParamCase" in line:
+            section = teardown
+    return setup, case_body, teardown
+
+
+def extract_instantiations(content: str) -> List[Tuple[int, int, str]]:
+    """返回所有 INSTANTIATE_TEST_SUITE_P 块的 (起始位置, 结束位置, 参数数组名)"""
+    blocks = []
+    for match in re.finditer(r'INSTANTIATE_TEST_SUITE_P\(', content):
+        depth = 1
+        idx = match.end()
+        while idx < len(content) and depth > 0:
+            if content[idx] == "(":
+                depth += 1
+            elif content[idx] == ")":
+                depth -= 1
+            idx += 1
+        end = content.index(";", idx) + 1
+        array_match = re.search(r'testing::ValuesIn\((\w+)\)', content[match.start():end])
+        blocks.append((match.start(), end, array_match.group(1) if array_match else "cases_params"))
+    return blocks
+
+
+def extract_case_name_field(content: str) -> str:
+    """从 INSTANTIATE 的命名 lambda 中提取用例名字段 (case_name / caseName / test_name)"""
+    match = re.search(r'info\.param\.(\w+)', content)
+    return match.group(1) if match else "case_name"
+
+
+def ensure_include(content: str, header: str, after: str = "#include <gtest/gtest.h>") -> str:
+    """在 after 所在行之后补充 #include，已存在时不重复添加"""
+    include_line = f"#include <{header}>"
+    if include_line in content:
+        return content
+    return content.replace(after, f"{after}\n{include_line}", 1)
+
+
+def build_batched_runner(content: str, body_template: str) -> str:
+    """
+    将 TEST_P + INSTANTIATE_TEST_SUITE_P 形式的参数化用例改写为批量执行代码：
+    - TEST_P 中的准备/清理代码 (如拓扑 mocker) 只执行一次，Mc2ExecuteTestCase 改为
+      UTGen::BatchedMc2ExecuteTestCase，拓扑 mock 按批设置 (见 utgen_tiling_exec.h 的 HcomMockBatch)；
+    - 每个用例的失败被单独截获，最后以带用例名的结构化报告统一上报。
+    body_template 决定批量入口的形态 (gtest TEST_F 或用例库导出函数)。
+    """
+    start, end, suite, test_name, body = extract_test_p_block(content)
+    instantiations = extract_instantiations(content)
+    if not instantiations:
+        raise ValueError("模板中未找到 INSTANTIATE_TEST_SUITE_P 定义")
+
+    setup, case_body, teardown = split_test_p_body(body)
+    setup_code = "\n".join(setup).strip("\n")
+    teardown_code = "\n".join(teardown).strip("\n")
+    case_body = [line.strip() for line in case_body if line.strip()]
+    run_tables = "\n".join(
+        f'        RunBatchedCases("{array}", {array}, caseCount, failureReport);' for _, _, array in instantiations
+    )
+    runner = BATCHED_RUNNER_TEMPLATE.format(
+        case_body="\n".join("            " + line for line in case_body),
+        name_field=extract_case_name_field(content),
+    )
+    runner += body_template.format(
+        suite=suite,
+        test_name=test_name,
+        setup=setup_code + "\n\n" if setup_code.strip() else "",
+        run_tables=run_tables,
+        teardown="\n" + teardown_code + "\n\n" if teardown_code.strip() else "\n",
+    )
+
+    # TEST_P 到最后一个 INSTANTIATE 之间只有参数化用例的注册代码，整体替换为批量入口
+    block_end = max(end, instantiations[-1][1])
+    content = content[:start] + runner.rstrip("\n") + content[block_end:]
+    # Mc2ExecuteTestCase 每次调用都会设置并复位 mocker，批量模式改由 HcomMockBatch 统一管理
+    content = re.sub(r'(?<![\w:])Mc2ExecuteTestCase\(', 'UTGen::BatchedMc2ExecuteTestCase(', content)
+    content = ensure_include(content, "gtest/gtest-spi.h")
+    content = ensure_include(content, "sstream", "#include <gtest/gtest-spi.h>")
+    content = ensure_include(content, "vector", "#include <sstream>")
+    return content
+
+
+def convert_to_batched_test(content: str) -> str:
+    """批量执行模式：复用原 fixture，以单个 TEST_F 遍历全部用例表"""
+    return build_batched_runner(content, BATCHED_TEST_TEMPLATE)
+
+
+def convert_to_case_library(content: str) -> str:
+    """
+    用例库模式：生成可编译为独立 .so 的翻译单元，导出 UTGenRunCaseLibrary 供常驻 runner 调用。
+    不向 gtest 注册任何用例，库可以被反复 dlopen/dlclose。
+    """
+    # 入口函数位于全局作用域；模板只有匿名命名空间时直接调用即可
+    namespace_match = re.search(r'^namespace\s+(\w+)\s*\{', content, re.MULTILINE)
+    qualifier = f"{namespace_match.group(1)}::" if namespace_match else ""
+    content = build_batched_runner(content, CASE_LIBRARY_RUN_TEMPLATE)
+    content = content.replace('#include "utgen_log.h"', '#include "utgen_log.h"\n#include "utgen_case_library.h"', 1)
+    return content.rstrip("\n") + "\n" + CASE_LIBRARY_ENTRY_TEMPLATE.format(qualifier=qualifier)
+
+
+# ============== 基准测试模式 ==============
+# 每个用例注册为一个 Google Benchmark，TEST_P 中的准备/清理代码包在用例体前后
+BENCH_REGISTER_TEMPLATE = """void RegisterTilingBenchmarks()
+{{
+{register_tables}
+}}
+
+const bool g_tilingBenchmarksRegistered = (RegisterTilingBenchmarks(), true);
+"""
+
+BENCH_TABLE_TEMPLATE = """    for (const auto &param : {array}) {{
+        UTGen::RegisterTilingBenchmark("{op}", param.{name_field}, [&param]() {{
+{body}
+        }});
+    }}"""
+
+
+def convert_to_benchmark(content: str) -> str:
+    """
+    基准测试模式：把生成的测试文件改写为 bench_<op>_tiling.cpp。
+    - TestOneParamCase 中的 Mc2ExecuteTestCase / ExecuteTestCase 替换为 UTGen::BenchTiling，
+      TilingContextPara 在计时循环外构造一次；
+    - TEST_P / INSTANTIATE_TEST_SUITE_P 替换为逐用例的 benchmark 注册。
+    """
+    start, end, _, _, body = extract_test_p_block(content)
+    instantiations = extract_instantiations(content)
+    if not instantiations:
+        raise ValueError("模板中未找到 INSTANTIATE_TEST_SUITE_P 定义")
+    op_match = re.search(r'TilingContextPara\s+tilingContextPara\(\s*"(\w+)"', content)
+    if not op_match:
+        raise ValueError("模板中未找到 TilingContextPara 的算子名")
+
+    setup, case_body, teardown = split_test_p_body(body)
+    body_lines = [line.strip() for line in setup + case_body + teardown]
+    lambda_body = "\n".join(("            " + line) if line else "" for line in body_lines).strip("\n")
+    register_tables = "\n".join(
+        BENCH_TABLE_TEMPLATE.format(
+            array=array, op=op_match.group(1), name_field=extract_case_name_field(content), body=lambda_body
+        )
+        for _, _, array in instantiations
+    )
+    register_code = BENCH_REGISTER_TEMPLATE.format(register_tables=register_tables)
+
+    block_end = max(end, instantiations[-1][1])
+    head = re.sub(r'\b(?:Mc2)?ExecuteTestCase\(', 'UTGen::BenchTiling(', content[:start])
+    # 结果采集与耗时预算检查会额外执行 tiling，基准模式下去掉
+    head = re.sub(r'\n[ \t]*UTGen::(?:CaptureTilingResult|ExpectTilingWithinBudget)\(.*\);', '', head)
+    content = head + register_code.rstrip("\n") + content[block_end:]
+    return content.replace('#include "utgen_tiling_probe.h"', '#include "utgen_tiling_probe.h"\n#include "utgen_bench.h"', 1)
+
+
 def generate_unit_test(state: WorkflowState) -> WorkflowState:
     """生成单元测试文件的主函数"""
     template_path = Path(state["template_file_path"])
@@ -756,7 +1350,8 @@ def generate_unit_test(state: WorkflowState) -> WorkflowState:
         state["output_path"] = str(output_path)
         return state
     
-    cases = read_jsonl(input_path)
+    cases, defaults = split_case_defaults(read_jsonl(input_path))
+    cases = apply_case_defaults(cases, defaults)
     
     if not cases:
         output_path.parent.mkdir(parents=True, exist_ok=True)
@@ -765,9 +1360,14 @@ def generate_unit_test(state: WorkflowState) -> WorkflowState:
         state["output_path"] = str(output_path)
         return state
     
+    if state.get("soc_profiles"):
+        cases = expand_soc_profiles(cases, state["soc_profiles"], template_content, state["operator_name"])
+
     const_def, common_value = generate_compile_info_const(mode, cases)
+    annotator = load_comm_annotator(state["operator_name"]) if state.get("annotate_comm", False) else None
     # 使用提取到的 struct_name 和 template_content
-    cases_code = generate_cases_params(mode, cases, struct_name, common_value, template_content)
+    cases_code = generate_cases_params(mode, cases, struct_name, common_value, template_content, defaults,
+                                       annotator)
     
     data_code_parts = []
     if const_def:
@@ -775,14 +1375,32 @@ def generate_unit_test(state: WorkflowState) -> WorkflowState:
         data_code_parts.append("")
     data_code_parts.append(cases_code)
     data_code_parts.append("")
+    # 基准模式不做断言，无需区分只记录结果的用例
+    record_only_cpp = "" if state.get("bench", False) else generate_record_only_cpp(cases)
+    if record_only_cpp:
+        data_code_parts.append(record_only_cpp)
+        data_code_parts.append("")
     
     data_code = "\n".join(data_code_parts)
     insert_pos = find_insert_position(template_content)
     output_content = template_content[:insert_pos] + "\n" + data_code + template_content[insert_pos:]
+    if record_only_cpp:
+        output_content = route_record_only_cases(output_content)
+
+    if state.get("bench", False):
+        output_content = convert_to_benchmark(output_content)
+    elif state.get("case_library", False):
+        output_content = convert_to_case_library(output_content)
+    elif state.get("batched", False):
+        output_content = convert_to_batched_test(output_content)
     
     output_path.parent.mkdir(parents=True, exist_ok=True)
     output_path.write_text(output_content, encoding="utf-8")
     print(f"生成完成: {output_path}")
+    if annotator is not None:
+        report_path = output_path.with_suffix(".comm.json")
+        report_path.write_text(json.dumps(annotator.report, ensure_ascii=False, indent=2), encoding="utf-8")
+        print(f"通信量报告: {report_path}")
     
     state["output_path"] = str(output_path)
     return state
@@ -8,11 +8,14 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <thread>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace AllGatherMatmulUT {
 
@@ -61,18 +64,20 @@ struct AllGatherMatmulTilingTestParam {
     bool is_trans_b;
 
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class AllGatherMatmulTilingParam : public ::testing::TestWithParam<AllGatherMatmulTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "AllGatherMatmulTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "AllGatherMatmulTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "AllGatherMatmulTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "AllGatherMatmulTiling TearDown";
     }
 };
 
@@ -122,7 +127,10 @@ void TestOneParamCase(const AllGatherMatmulTilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);
 
+    UTGen::TilingProbe probe("AllGatherMatmul", param.case_name, param.expectTilingKey);
     ExecuteTestCase(tilingContextPara, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara);
 }
 
 const std::string COMPILE_INFO = R"({"hardware_info": {"BT_SIZE": 0, "load3d_constraints": "1", "Intrinsic_fix_pipe_l0c2out": false, "Intrinsic_data_move_l12ub": true, "Intrinsic_data_move_l0c2ub": true, "Intrinsic_data_move_out2l1_nd2nz": false, "UB_SIZE": 196608, "L2_SIZE": 33554432, "L1_SIZE": 524288, "L0A_SIZE": 65536, "L0B_SIZE": 65536, "L0C_SIZE": 131072, "CORE_NUM": 20, "socVersion": "Ascend910B"}})";
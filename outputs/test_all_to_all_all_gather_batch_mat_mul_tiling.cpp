@@ -8,13 +8,16 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <vector>
 #include <string>
 #include <cctype>
 
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace AlltoAllAllGatherBatchMatMulUT {
 
@@ -50,18 +53,20 @@ struct AlltoAllAllGatherBmmTilingTestParam {
 
     bool has_expect_tiling_key;
     uint64_t expect_tiling_key;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
  
 class AlltoAllAllGatherBmmTilingParam : public ::testing::TestWithParam<AlltoAllAllGatherBmmTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "AlltoAllAllGatherBmmTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "AlltoAllAllGatherBmmTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "AlltoAllAllGatherBmmTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "AlltoAllAllGatherBmmTiling TearDown";
     }
 };
 
@@ -115,12 +120,16 @@ void TestOneParamCase(const AlltoAllAllGatherBmmTilingTestParam &param)
         param.ubSize,
         param.tilingDataSize);
 
+    UTGen::TilingProbe probe("AlltoAllAllGatherBatchMatMul", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.has_expect_tiling_key) {
+        probe.SetTilingKey(param.expect_tiling_key);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expect_tiling_key);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 AlltoAllAllGatherBmmTilingTestParam cases_params[] = {
@@ -8,7 +8,6 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <map>
 #include <vector>
 #include <string>
@@ -19,6 +18,10 @@
 #include <opdev/platform.h>
 #include <gmock/gmock.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace BatchMatMulReduceScatterAlltoAllUT {
 
@@ -33,6 +36,7 @@ auto build_from(const T &value)
 struct BatchMatMulReduceScatterAlltoAllTilingTestParam {
     uint64_t inputTotalNum;
     std::string case_name;
+    std::string soc_version;
     uint64_t coreNum;
     uint64_t ubSize;
 
@@ -56,6 +60,8 @@ struct BatchMatMulReduceScatterAlltoAllTilingTestParam {
 
     bool hasExpectTilingKey;
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class BatchMatMulReduceScatterAlltoAllTilingParam
@@ -63,12 +69,12 @@ class BatchMatMulReduceScatterAlltoAllTilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "BatchMatMulReduceScatterAlltoAllTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "BatchMatMulReduceScatterAlltoAllTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "BatchMatMulReduceScatterAlltoAllTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "BatchMatMulReduceScatterAlltoAllTiling TearDown";
     }
 };
 
@@ -112,37 +118,41 @@ void TestOneParamCase(const BatchMatMulReduceScatterAlltoAllTilingTestParam &par
             {"y_shard_type", build_from<int64_t>(param.y_shard_type)},
             {"transpose_weight", build_from<bool>(param.transpose_weight)},
         },
-        &compileInfo, "Ascend910_93", param.coreNum, param.ubSize);
+        &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("BatchMatMulReduceScatterAlltoAll", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.hasExpectTilingKey) {
+        probe.SetTilingKey(param.expectTilingKey);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 BatchMatMulReduceScatterAlltoAllTilingTestParam cases_params[] = {
-    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_1", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001001UL},
-    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_1_weight_trans", 20, 196608, {2, 1024, 64}, {2, 128, 64}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, true, true, 1000000000000001011UL},
-    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_M_0", 20, 196608, {2, 1024, 0}, {2, 0, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001001UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001101UL},
-    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_0", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "ep_group", 8, 2, 0, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test1", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 3, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test2", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "ep_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test3", 20, 196608, {1, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test4", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128, 1}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test5", 20, 196608, {}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test6", 20, 196608, {1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test7", 20, 196608, {2, 1024, 0}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test8", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {3, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, true, 1000000000000000100UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_nonlocalE_tail_front", 20, 196608, {17, 3868, 637}, {17, 637, 2366}, {17, 1, 1183}, {68, 967, 1183}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 4, 2, 0, false, true, 1000000000000000100UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_bf16_shard0_with_bias", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_BF16, ge::DT_BF16, ge::DT_FLOAT, ge::DT_BF16, "ep_group", "tp_group", 8, 2, 0, false, true, 1000000000000000100UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias_invalid_Xshape", 20, 196608, {2, 1020, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard1_with_bias_invalid_Xshape", 20, 196608, {2, 1020, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
-    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias_invalid_H", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, false, 0UL},
+    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_1", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001001UL},
+    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_1_weight_trans", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 128, 64}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, true, true, 1000000000000001011UL},
+    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_M_0", "Ascend910_93", 20, 196608, {2, 1024, 0}, {2, 0, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001001UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, true, 1000000000000001101UL},
+    {2, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_0", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "ep_group", 8, 2, 0, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test1", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 3, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test2", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "ep_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test3", "Ascend910_93", 20, 196608, {1, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test4", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128, 1}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test5", "Ascend910_93", 20, 196608, {}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test6", "Ascend910_93", 20, 196608, {1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test7", "Ascend910_93", 20, 196608, {2, 1024, 0}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_float16_shard_with_bias_test8", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {3, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, true, 1000000000000000100UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_nonlocalE_tail_front", "Ascend910_93", 20, 196608, {17, 3868, 637}, {17, 637, 2366}, {17, 1, 1183}, {68, 967, 1183}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 4, 2, 0, false, true, 1000000000000000100UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_bf16_shard0_with_bias", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_BF16, ge::DT_BF16, ge::DT_FLOAT, ge::DT_BF16, "ep_group", "tp_group", 8, 2, 0, false, true, 1000000000000000100UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias_invalid_Xshape", "Ascend910_93", 20, 196608, {2, 1020, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard1_with_bias_invalid_Xshape", "Ascend910_93", 20, 196608, {2, 1020, 64}, {2, 64, 128}, {2, 1, 64}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 1, false, false, 0UL},
+    {3, "batch_matmul_reduce_scatter_all_to_all_test_tiling_fp16_shard0_with_bias_invalid_H", "Ascend910_93", 20, 196608, {2, 1024, 64}, {2, 64, 128}, {2, 1, 128}, {16, 128, 64}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, "ep_group", "tp_group", 8, 2, 0, false, false, 0UL},
 };
 
 TEST_P(BatchMatMulReduceScatterAlltoAllTilingParam, general_case)
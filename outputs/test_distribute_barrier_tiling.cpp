@@ -8,11 +8,14 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <vector>
 #include <string>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 using namespace std;
 
@@ -32,18 +35,20 @@ struct DistributeBarrierTilingTestParam {
     std::string expectTilingData;
     std::vector<size_t> expectWorkspaces;
     uint64_t mc2TilingDataReservedLen;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class DistributeBarrierTilingParam : public ::testing::TestWithParam<DistributeBarrierTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "DistributeBarrierTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "DistributeBarrierTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "DistributeBarrierTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "DistributeBarrierTiling TearDown";
     }
 };
 
@@ -57,9 +62,12 @@ void TestOneParamCase(const DistributeBarrierTilingTestParam &param)
          {"world_size", Ops::Transformer::AnyValue::CreateFrom<int64_t>(param.world_size)}},
         &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("DistributeBarrier", param.case_name, param.expectTilingKey);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey,
         param.expectTilingData, param.expectWorkspaces, param.mc2TilingDataReservedLen);
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 const std::string COMPILE_INFO = "8 8 20 196352 0 0 ";
@@ -8,9 +8,12 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 #include <gtest/gtest.h>
-#include <iostream>
 #include <cctype>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 #include "../../../op_host/op_tiling/quant_matmul_all_reduce_add_rms_norm_tiling.h"
 #include "../../../op_host/op_tiling/matmul_all_reduce_add_rms_norm_tiling.h"
 #include "../../../op_host/op_tiling/weight_quant_matmul_all_reduce_add_rms_norm_tiling.h"
@@ -29,57 +32,71 @@ struct TestParam {
     std::string caseName;
     uint32_t blockDim;
     uint64_t tilingKey;
+    // 硬件参数，JSONL 中未指定时由生成器填入 Ascend910B / 8 核 / 262144 UB
+    std::string socVersion;
+    uint64_t coreNum;
+    uint64_t ubSize;
+
+    bool isInvalidCase;
+    std::string groupName;
+    std::string reduceOp;
+    bool transA;
+    bool transB;
+    int64_t antigroupSize;
+    float epsilon;
+
+    // 以下 shape 由生成器根据用例参数预先计算，空列表表示该可选输入不存在
+    std::initializer_list<int64_t> xShape;
+    std::initializer_list<int64_t> weightShape;
+    std::initializer_list<int64_t> biasShape;
+    std::initializer_list<int64_t> yShape;
+    std::initializer_list<int64_t> gammaShape;
+    std::initializer_list<int64_t> antiquantOffsetShape;
+    std::initializer_list<int64_t> antiquantScaleStorageShape;
+    std::initializer_list<int64_t> antiquantScaleOriginShape;
+    std::initializer_list<int64_t> quantScaleShape;
+
+    ge::DataType xDtype;
+    ge::DataType weightDtype;
+    ge::DataType biasDtype;
+    ge::DataType yDtype;
+    ge::DataType quantScaleDtype;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 using WeightQuantTestParam = TestParam;
 
-std::unique_ptr<gert::TilingContextPara::TensorDescription> CreateTensorShape(
-    gert::StorageShape shape,
-    ge::DataType dtype,
-    ge::Format format)
-{
-    return std::unique_ptr<gert::TilingContextPara::TensorDescription>(
-        new gert::TilingContextPara::TensorDescription(
-            shape,
-            dtype,
-            format));
-}
-
 class MatmulAllReduceAddRmsNormTiling : public ::testing::TestWithParam<TestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MatmulAllReduceAddRmsNormTiling Test SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceAddRmsNormTiling Test SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MatmulAllReduceAddRmsNormTiling Test TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceAddRmsNormTiling Test TearDown";
     }
 };
 
-static void SplitStr2Vec(const std::string &input, const std::string &delimiter,
-                         std::vector<std::string> &output)
+gert::StorageShape make_shape(const std::initializer_list<int64_t> &input_shape)
 {
-    auto delimiterLen = delimiter.size();
-    std::string::size_type currPos = 0;
-    std::string::size_type nextPos = input.find(delimiter, currPos);
-    while (nextPos != std::string::npos) {
-        output.emplace_back(input.substr(currPos, nextPos - currPos));
-        currPos = nextPos + delimiterLen;
-        nextPos = input.find(delimiter, currPos);
+    if (input_shape.size() == 0) {
+        return gert::StorageShape{};
     }
+    return gert::StorageShape{input_shape, input_shape};
+}
 
-    if (currPos < input.size()) {
-        output.emplace_back(input.substr(currPos));
+gert::StorageShape make_shape(const std::initializer_list<int64_t> &storage_shape,
+                              const std::initializer_list<int64_t> &origin_shape)
+{
+    if (storage_shape.size() == 0) {
+        return gert::StorageShape{};
     }
+    return gert::StorageShape{storage_shape, origin_shape};
 }
 
-std::map<std::string, ge::DataType> dtypeMap = {
-    {"FLOAT16", ge::DT_FLOAT16}, {"FLOAT", ge::DT_FLOAT},   {"BF16", ge::DT_BF16},
-    {"INT8", ge::DT_INT8},       {"INT4", ge::DT_INT4},     {"UINT64", ge::DT_UINT64},
-    {"INT32", ge::DT_INT32}};
-
 struct MatmulAllReduceArnCompileInfo{
     int32_t totalCoreNum = 0;
     uint64_t ubSize = 0;    
@@ -87,173 +104,121 @@ struct MatmulAllReduceArnCompileInfo{
 
 static void TestOneParamCase(const WeightQuantTestParam &param)
 {
-    std::cout << "run case " << param.caseName << std::endl;
-    std::vector<std::string> testParam;
-    SplitStr2Vec(param.caseName, "_", testParam);
-
-    std::size_t idx = 0;
-    std::string model_name = testParam[idx++];
-    bool is_valid_case = false;
-    if (model_name.find("InValid") != std::string::npos) {
-        is_valid_case = true;
-    }
-    std::string group_name = testParam[idx++];
-    std::string reduce_op = testParam[idx++];
-
-    int64_t m = stol(testParam[idx++]);
-    int64_t k = stol(testParam[idx++]);
-    int64_t n = stol(testParam[idx++]);
-
-    int64_t biasFlag = stol(testParam[idx++]);
-    int64_t x3Flag = stol(testParam[idx++]);
-    int64_t transA = stol(testParam[idx++]);
-    int64_t transB = stol(testParam[idx++]);
-    int64_t group = stol(testParam[idx++]);
-    int64_t antiquant_offsetExistFlag = stol(testParam[idx++]);
-    int64_t antiquant_scaleExistFlag = stol(testParam[idx++]);
-    int64_t dequant_scaleExistFlag = stol(testParam[idx++]);
-    int64_t antigroupSize = stol(testParam[idx++]);
-    float epslion = stof(testParam[idx++]);
-
-    ge::DataType xDtype = dtypeMap[testParam[idx++]];
-    ge::DataType weightDtype = dtypeMap[testParam[idx++]];
-    ge::DataType biasDtype = dtypeMap[testParam[idx++]];
-    ge::DataType yDtype = dtypeMap[testParam[idx++]];
-    ge::DataType normOutDtype = yDtype;
-    ge::DataType quantDtype = yDtype;
-
-    auto xShape = CreateTensorShape({}, xDtype, ge::FORMAT_ND);
-    auto weigthShape = CreateTensorShape({}, weightDtype, ge::FORMAT_ND);
-    auto biasShape = CreateTensorShape({}, biasDtype, ge::FORMAT_ND);
-    auto residualShape = CreateTensorShape({{1, m, n}, {1, m, n}}, yDtype, ge::FORMAT_ND);
-    auto gammaShape = CreateTensorShape({{n}, {n}}, yDtype, ge::FORMAT_ND);
-    auto antiQuantOffsetShape = CreateTensorShape({}, xDtype, ge::FORMAT_ND);
-    auto antiQuantScaleShape = CreateTensorShape({}, xDtype, ge::FORMAT_ND);
-    auto quantScaleShape = CreateTensorShape({}, quantDtype, ge::FORMAT_ND);
-    auto yShape = CreateTensorShape({{1, m, n}, {1, m, n}}, yDtype, ge::FORMAT_ND);
-
-    auto normOutputShape = CreateTensorShape({{1, m, n}, {1, m, n}}, normOutDtype, ge::FORMAT_ND);
-
-    if (transA) {
-        xShape->shape_ = {{k, m}, {k, m}};
-    } else {
-        xShape->shape_ = {{m, k}, {m, k}};
-    }
-
-    if (transB) {
-        weigthShape->shape_ = {{n, k}, {n, k}};
-    } else {
-        weigthShape->shape_ = {{k, n}, {k, n}};
-    }
-
-    {
-        if (group > 0) {
-            int64_t groupNum = (k + group - 1) / group;
-            if (transB) {
-                antiQuantOffsetShape->shape_ = {{n, groupNum}, {n, groupNum}};
-                antiQuantScaleShape->shape_ = {{n, groupNum}, {m, groupNum}};
-            } else {
-                antiQuantOffsetShape->shape_ = {{groupNum, n}, {groupNum, n}};
-                antiQuantScaleShape->shape_ = {{groupNum, n}, {groupNum, n}};
-            }
-        } else if (group < 0) {
-            antiQuantOffsetShape->shape_ = {{n}, {n}};
-            antiQuantScaleShape->shape_ = {{n}, {n}};
-            quantScaleShape->shape_ = {{n}, {n}};
-            if (yDtype != ge::DT_BF16) {
-                quantDtype = ge::DT_UINT64;
-            }
-        } else {
-            antiQuantOffsetShape->shape_ = {{1}, {1}};
-            antiQuantScaleShape->shape_ = {{1}, {1}};
-            quantScaleShape->shape_ = {{1}, {1}};
-            if (yDtype != ge::DT_BF16) {
-                quantDtype = ge::DT_UINT64;
-            }
-        }
-    }
-    quantScaleShape->dtype_ = quantDtype;
-    if (biasFlag){
-        biasShape->shape_ = {{n}, {n}};
-    }
-    if (!antiquant_offsetExistFlag){
-        antiQuantOffsetShape->shape_ = {};
-    }
-    if (!antiquant_scaleExistFlag){
-        antiQuantScaleShape->shape_ = {};
-    }
-    if (!dequant_scaleExistFlag){
-        quantScaleShape->shape_ = {};
-    }
-    if (yShape->dtype_ == ge::DT_BF16) {
-        printf("the yDtype is BF16\n");
-    } else {
-        printf("Exist error!\n");
-    }
-    printf("dataType BF16 is : %d",ge::DataType::DT_BF16);
-    MatmulAllReduceArnCompileInfo compileInfo {8, 262144};
-    const std::string socVersion = "Ascend910B";
-    uint64_t coreNum = 8;
-    uint64_t ubSize = 262144;
+    MatmulAllReduceArnCompileInfo compileInfo {static_cast<int32_t>(param.coreNum), param.ubSize};
     uint64_t tilingDataSize = 40960;
     gert::TilingContextPara tilingContextPara("MatmulAllReduceAddRmsNorm",
         {
-            *xShape,
-            *weigthShape,
-            *biasShape,
-            *residualShape,
-            *gammaShape,
-            *antiQuantOffsetShape,
-            *antiQuantScaleShape,
-            *quantScaleShape,
+            {make_shape(param.xShape), param.xDtype, ge::FORMAT_ND},
+            {make_shape(param.weightShape), param.weightDtype, ge::FORMAT_ND},
+            {make_shape(param.biasShape), param.biasDtype, ge::FORMAT_ND},
+            {make_shape(param.yShape), param.yDtype, ge::FORMAT_ND},
+            {make_shape(param.gammaShape), param.yDtype, ge::FORMAT_ND},
+            {make_shape(param.antiquantOffsetShape), param.xDtype, ge::FORMAT_ND},
+            {make_shape(param.antiquantScaleStorageShape, param.antiquantScaleOriginShape), param.xDtype,
+             ge::FORMAT_ND},
+            {make_shape(param.quantScaleShape), param.quantScaleDtype, ge::FORMAT_ND},
         },
         {
-            *yShape,
-            *normOutputShape,
+            {make_shape(param.yShape), param.yDtype, ge::FORMAT_ND},
+            {make_shape(param.yShape), param.yDtype, ge::FORMAT_ND},
         },
         {
-            {"group", build_from<std::string>(group_name)},
-            {"reduce_op", build_from<std::string>(reduce_op)},
-            {"is_trans_a", build_from<bool>(static_cast<bool>(transA))},
-            {"is_trans_b", build_from<bool>(static_cast<bool>(transB))},
+            {"group", build_from<std::string>(param.groupName)},
+            {"reduce_op", build_from<std::string>(param.reduceOp)},
+            {"is_trans_a", build_from<bool>(param.transA)},
+            {"is_trans_b", build_from<bool>(param.transB)},
             {"comm_turn", build_from<int64_t>(0)},
-            {"antiquant_group_size", build_from<int64_t>(antigroupSize)},
-            {"epslion", build_from<float>(epslion)},
+            {"antiquant_group_size", build_from<int64_t>(param.antigroupSize)},
+            {"epslion", build_from<float>(param.epsilon)},
         },
         &compileInfo,
-        socVersion,
-        coreNum,
-        ubSize,
+        param.socVersion,
+        param.coreNum,
+        param.ubSize,
         tilingDataSize);
+    UTGen::TilingProbe probe("MatmulAllReduceAddRmsNorm", param.caseName);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
-    if (is_valid_case) {
+    if (param.isInvalidCase) {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_FAILED, param.tilingKey);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 static TestParam casesParamsQuant[] = {
-        {"MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0},
-        {"MODEL0_group_sum_4_4096_11008_1_0_0_1_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 1},
-        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_-1_0_0_1_10_0.1_INT8_INT8_INT32_BF16", 8, 0},
-        {"MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_1_1_0_0_0.1_FLOAT16_INT8_FLOAT16_FLOAT16", 8, 365332065878785},
-        {"MODEL0_group_sum_4_4096_11008_1_0_0_1_-1_1_1_0_0_0.1_FLOAT16_INT4_FLOAT16_FLOAT16", 8, 365332602749697},
-        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_32_1_1_0_32_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609},
-        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_32_0_0_0_32_0.1_BF16_BF16_BF16_BF16", 8, 65536},
-        {"MODEL0_group_sum_9471_18_379_1_0_0_0_32_0_0_0_32_0.1_BF16_BF16_BF16_BF16", 8, 65536},
+        {"MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 0, 0.1f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"MODEL0_group_sum_4_4096_11008_1_0_0_1_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 1, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, true, 0, 0.1f,
+            {4, 4096}, {11008, 4096}, {11008}, {1, 4, 11008}, {11008}, {}, {}, {}, {11008},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_-1_0_0_1_10_0.1_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 10, 0.1f,
+            {4, 4096}, {4096, 11008}, {11008}, {1, 4, 11008}, {11008}, {}, {}, {}, {11008},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_1_1_0_0_0.1_FLOAT16_INT8_FLOAT16_FLOAT16", 8, 365332065878785, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 0, 0.1f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {4096}, {4096}, {4096}, {},
+            ge::DT_FLOAT16, ge::DT_INT8, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_UINT64},
+        {"MODEL0_group_sum_4_4096_11008_1_0_0_1_-1_1_1_0_0_0.1_FLOAT16_INT4_FLOAT16_FLOAT16", 8, 365332602749697, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, true, 0, 0.1f,
+            {4, 4096}, {11008, 4096}, {11008}, {1, 4, 11008}, {11008}, {11008}, {11008}, {11008}, {},
+            ge::DT_FLOAT16, ge::DT_INT4, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_UINT64},
+        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_32_1_1_0_32_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 32, 0.1f,
+            {4, 4096}, {4096, 11008}, {11008}, {1, 4, 11008}, {11008}, {128, 11008}, {128, 11008}, {128, 11008}, {},
+            ge::DT_BF16, ge::DT_INT4, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"MODEL0_group_sum_4_4096_11008_1_0_0_0_32_0_0_0_32_0.1_BF16_BF16_BF16_BF16", 8, 65536, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 32, 0.1f,
+            {4, 4096}, {4096, 11008}, {11008}, {1, 4, 11008}, {11008}, {}, {}, {}, {},
+            ge::DT_BF16, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"MODEL0_group_sum_9471_18_379_1_0_0_0_32_0_0_0_32_0.1_BF16_BF16_BF16_BF16", 8, 65536, "Ascend910B", 8, 262144,
+            false, "group", "sum", false, false, 32, 0.1f,
+            {9471, 18}, {18, 379}, {379}, {1, 9471, 379}, {379}, {}, {}, {}, {},
+            ge::DT_BF16, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
 
 };
 static TestParam InValidCheckcasesParamsQuant[] = {
-        {"InValidMODEL0_group_sum_4_4096_11008_1_0_0_0_-1_1_1_1_10_0.1_INT8_INT8_BF16_BF16", 8, 365333139620609},
-        {"InValidMODEL0_group_sum_4096_688_4096_1_0_1_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0},
-        {"InValidMODEL0_group_sum_4096_688_4096_1_0_1_0_-1_1_1_0_0_0.1_BF16_INT8_BF16_BF16", 8, 365332065878785},
-        {"InValidMODEL0_group_sum_4_4096_11008_1_0_0_0_32_1_1_0_30_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609},
-        {"InValidMODEL0_group_sum_4_2_11008_1_0_0_0_32_1_1_0_32_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609},
-        {"InValidMODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0_INT8_INT8_INT32_BF16", 8, 0},
-        {"InValidMODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_1_INT8_INT8_INT32_BF16", 8, 0},
-        {"InValidMODEL0_group_mul_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0},
-        {"InValidMODEL0_group_mul_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16_CommTurn", 8, 0},
+        {"InValidMODEL0_group_sum_4_4096_11008_1_0_0_0_-1_1_1_1_10_0.1_INT8_INT8_BF16_BF16", 8, 365333139620609, "Ascend910B", 8, 262144,
+            true, "group", "sum", false, false, 10, 0.1f,
+            {4, 4096}, {4096, 11008}, {11008}, {1, 4, 11008}, {11008}, {11008}, {11008}, {11008}, {11008},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4096_688_4096_1_0_1_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            true, "group", "sum", true, false, 0, 0.1f,
+            {688, 4096}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4096_688_4096_1_0_1_0_-1_1_1_0_0_0.1_BF16_INT8_BF16_BF16", 8, 365332065878785, "Ascend910B", 8, 262144,
+            true, "group", "sum", true, false, 0, 0.1f,
+            {688, 4096}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {4096}, {4096}, {4096}, {},
+            ge::DT_BF16, ge::DT_INT8, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4_4096_11008_1_0_0_0_32_1_1_0_30_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609, "Ascend910B", 8, 262144,
+            true, "group", "sum", false, false, 30, 0.1f,
+            {4, 4096}, {4096, 11008}, {11008}, {1, 4, 11008}, {11008}, {128, 11008}, {128, 11008}, {128, 11008}, {},
+            ge::DT_BF16, ge::DT_INT4, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4_2_11008_1_0_0_0_32_1_1_0_32_0.1_BF16_INT4_BF16_BF16", 8, 365333139620609, "Ascend910B", 8, 262144,
+            true, "group", "sum", false, false, 32, 0.1f,
+            {4, 2}, {2, 11008}, {11008}, {1, 4, 11008}, {11008}, {1, 11008}, {1, 11008}, {1, 11008}, {},
+            ge::DT_BF16, ge::DT_INT4, ge::DT_BF16, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            true, "group", "sum", false, false, 0, 0.0f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_1_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            true, "group", "sum", false, false, 0, 1.0f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_mul_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16", 8, 0, "Ascend910B", 8, 262144,
+            true, "group", "mul", false, false, 0, 0.1f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
+        {"InValidMODEL0_group_mul_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16_CommTurn", 8, 0, "Ascend910B", 8, 262144,
+            true, "group", "mul", false, false, 0, 0.1f,
+            {4096, 688}, {688, 4096}, {4096}, {1, 4096, 4096}, {4096}, {}, {}, {}, {4096},
+            ge::DT_INT8, ge::DT_INT8, ge::DT_INT32, ge::DT_BF16, ge::DT_BF16},
 
 };
 
@@ -8,10 +8,13 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MatmulAllReduceUT {
 template <typename T>
@@ -56,18 +59,20 @@ struct MatmulAllReduceTilingTestParam {
     bool is_trans_b;
 
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class MatmulAllReduceTilingParam : public ::testing::TestWithParam<MatmulAllReduceTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MatmulAllReduceTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MatmulAllReduceTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceTiling TearDown";
     }
 };
 
@@ -117,7 +122,10 @@ void TestOneParamCase(const MatmulAllReduceTilingTestParam& param){
         },
         &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);
 
+    UTGen::TilingProbe probe("MatmulAllReduce", param.case_name, param.expectTilingKey);
     ExecuteTestCase(tilingContextPara, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara);
 }
 
 const string COMPILE_INFO = R"({"hardware_info": {"BT_SIZE": 0, "load3d_constraints": "1", "Intrinsic_fix_pipe_l0c2out": false, "Intrinsic_data_move_l12ub": true, "Intrinsic_data_move_l0c2ub": true, "Intrinsic_data_move_out2l1_nd2nz": false, "UB_SIZE": 196608, "L2_SIZE": 33554432, "L1_SIZE": 524288, "L0A_SIZE": 65536, "L0B_SIZE": 65536, "L0C_SIZE": 131072, "CORE_NUM": 20, "socVersion": "Ascend910B"}})";
@@ -131,7 +139,7 @@ MatmulAllReduceTilingTestParam cases_params[] = {
     {4, "matmul_all_reduce_test_tiling_float16_3", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {128, 1536}, {1536, 8192}, {}, {}, {}, {}, {}, {}, {}, {}, {8192, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 260UL},
     {4, "matmul_all_reduce_test_tiling_float16_2", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {8192, 1536}, {1536, 12288}, {}, {}, {}, {}, {}, {}, {}, {}, {8192, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, true, true, 260UL},
     {4, "matmul_all_reduce_test_mcut_float16_910B_win2win", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {12290, 15360}, {15360, 12288}, {}, {}, {}, {}, {}, {}, {}, {}, {12290, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 260UL},
-    {4, "matmul_all_reduce_test_tiling_big_K", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {8192, 0xFFFFFFF}, {0xFFFFFFF, 12288}, {}, {8192, 12288}, {}, {}, {}, {}, {}, {}, {8192, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 256UL},
+    {4, "matmul_all_reduce_test_tiling_big_K", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {8192, 0xFFFFFFF}, {0xFFFFFFF, 12288}, {}, {8192, 12288}, {}, {}, {}, {}, {}, {}, {8192, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 256UL, {1000.0}},
     {4, "matmul_all_reduce_test_tiling_big_N", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {8192, 1536}, {1536, 0xFFFFFFF}, {}, {8192, 0xFFFFFFF}, {}, {}, {}, {}, {}, {}, {8192, 0xFFFFFFF}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 256UL},
     {4, "matmul_all_reduce_test_tiling_float16_unaligned", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {1, 65536}, {65536, 128}, {}, {}, {}, {}, {}, {}, {}, {}, {1, 128}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 260UL},
     {4, "matmul_all_reduce_test_tiling_float16_1_cube", COMPILE_INFO, "Ascend910B", 20, 196608, 4096, {8192, 1536}, {1536, 12288}, {}, {}, {}, {}, {}, {}, {}, {}, {8192, 12288}, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT16, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT, ge::DT_FLOAT16, false, false, 260UL},
@@ -8,10 +8,13 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MatmulReduceScatterV2UT {
 
@@ -45,6 +48,8 @@ struct MatmulReduceScatterV2TilingTestParam {
     bool is_trans_b;
 
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class MatmulReduceScatterV2TilingParam
@@ -52,12 +57,12 @@ class MatmulReduceScatterV2TilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MatmulReduceScatterV2Tiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulReduceScatterV2Tiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MatmulReduceScatterV2Tiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulReduceScatterV2Tiling TearDown";
     }
 };
 
@@ -106,8 +111,11 @@ void TestOneParamCase(const MatmulReduceScatterV2TilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize, param.tilingDataSize, param.compile_info);
 
+    UTGen::TilingProbe probe("MatmulReduceScatterV2", param.case_name, param.expectTilingKey);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 const string COMPILE_INFO = R"({"hardware_info": {"BT_SIZE": 0, "load3d_constraints": "1", "Intrinsic_fix_pipe_l0c2out": false, "Intrinsic_data_move_l12ub": true, "Intrinsic_data_move_l0c2ub": true, "Intrinsic_data_move_out2l1_nd2nz": false, "UB_SIZE": 196608, "L2_SIZE": 33554432, "L1_SIZE": 524288, "L0A_SIZE": 65536, "L0B_SIZE": 65536, "L0C_SIZE": 131072, "CORE_NUM": 20, "socVersion": "Ascend910_95"}})";
@@ -8,11 +8,14 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <thread>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MoeDistributeDispatchUT {
 
@@ -65,6 +68,8 @@ struct MoeDistributeCombineTilingTestParam {
 
     bool has_expect_tiling_key;
     uint64_t expect_tiling_key;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 gert::StorageShape make_shape(const std::initializer_list<int64_t> &shape)
@@ -79,12 +84,12 @@ class MoeDistributeCombineTilingParam : public ::testing::TestWithParam<MoeDistr
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MoeDistributeCombineTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeCombineTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MoeDistributeCombineTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeCombineTiling TearDown";
     }
 };
 
@@ -125,12 +130,16 @@ void TestOneParamCase(const MoeDistributeCombineTilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("MoeDistributeCombine", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.has_expect_tiling_key) {
+        probe.SetTilingKey(param.expect_tiling_key);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expect_tiling_key);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 MoeDistributeCombineTilingTestParam cases_params[] = {
@@ -37,11 +37,12 @@ for file in $(ls "$INPUT_DIR"/*.jsonl | sort); do
     echo ""
     echo "--------------------------------------------------------"
     echo "[$total] 正在处理算子: $op_name"
-    echo "CMD: python3 workflow.py -n $op_name -t op_host"
+    echo "CMD: python3 workflow.py -n $op_name -t op_host $*"
     echo "--------------------------------------------------------"
 
     # 执行 workflow.py
-    python3 "$WORKFLOW_PY" -n "$op_name" -t op_host
+    # 额外参数 (如 --batched) 透传给 workflow.py
+    python3 "$WORKFLOW_PY" -n "$op_name" -t op_host "$@"
 
     # 检查执行结果
     if [ $? -eq 0 ]; then
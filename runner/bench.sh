@@ -0,0 +1,155 @@
+#!/bin/bash
+
+# 脚本功能：编译并运行 tiling 基准测试 (workflow.py --bench 生成的 bench_<op>_tiling.cpp)
+# 使用方法:
+#   ./runner/bench.sh build <op> [<op>...]          # 编译指定算子的基准测试
+#   ./runner/bench.sh run <op> [benchmark 参数...]   # 运行，参数透传给 Google Benchmark
+#
+# 典型流程:
+#   python3 workflow.py -n all_gather_matmul --bench
+#   ./runner/bench.sh build all_gather_matmul
+#   ./runner/bench.sh run all_gather_matmul --benchmark_out=agmm.json --benchmark_out_format=json
+#
+# 环境变量:
+#   BENCHMARK_ROOT            Google Benchmark 安装目录 (包含 include/ 与 lib/)，未设置时使用系统路径
+#   UTGEN_BENCH_CPU           绑核的 CPU 编号，-1 不绑核
+#   UTGEN_BENCH_WARMUP_S      每个用例的预热时长 (秒)
+#   UTGEN_BENCH_REPETITIONS   重复次数
+#
+# 编译参数与链接命令复用 ops-transformer 的 UT 构建 (见 ut_build_env.sh)；源文件在临时目录中编译，
+# 不向 ops-transformer 检出写入任何源文件或 CMake 改动。需要 Google Benchmark >= 1.6。
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )"
+source "${SCRIPT_DIR}/ut_build_env.sh"
+
+UTGEN_BENCH_SRC_DIR="${UTGEN_DIR}/outputs/bench"
+BENCH_DIR="${UTGEN_BENCH_DIR:-${BUILD_DIR}/utgen_bench}"
+
+benchmark_flags() {
+    if [[ -n "$BENCHMARK_ROOT" ]]; then
+        echo "-I${BENCHMARK_ROOT}/include"
+    fi
+}
+
+benchmark_libs() {
+    if [[ -n "$BENCHMARK_ROOT" ]]; then
+        echo "-L${BENCHMARK_ROOT}/lib -Wl,-rpath,${BENCHMARK_ROOT}/lib -lbenchmark -lpthread"
+    else
+        echo "-lbenchmark -lpthread"
+    fi
+}
+
+# 探测 benchmark::MemoryManager::Stop 的签名：>= 1.8 为 Stop(Result &)，1.6/1.7 为纯虚的 Stop(Result *)
+# 两种都编译不过说明版本低于 1.6 (Result 缺少 total_allocated_bytes 等字段)
+benchmark_stop_flag() {
+    local compiler="$1"
+    local flags="$2"
+    local probe_src="$3"
+    local signature
+    for signature in "Result &r" "Result *r"; do
+        local access="r."
+        [[ "$signature" == *"*"* ]] && access="r->"
+        cat > "$probe_src" <<PROBE
+#include <benchmark/benchmark.h>
+struct Probe : benchmark::MemoryManager {
+    void Start() override {}
+    void Stop(${signature}) override { ${access}total_allocated_bytes = 0; ${access}net_heap_growth = 0; }
+};
+Probe probe;
+PROBE
+        if eval "$compiler $flags $(benchmark_flags) -fsyntax-only \"$probe_src\"" &> /dev/null; then
+            [[ "$signature" == *"*"* ]] && echo "-DUTGEN_BENCH_STOP_BY_POINTER=1"
+            return 0
+        fi
+    done
+    return 1
+}
+
+# 编译单个算子的基准测试；在 ops 检出之外的临时目录中编译，模板中的相对 include 通过 -I 指向算子 UT 目录解析
+build_bench() {
+    local op_name="$1"
+    local src="${UTGEN_BENCH_SRC_DIR}/bench_${op_name}_tiling.cpp"
+    local ut_dir="${MC2_DIR}/${op_name}/tests/ut/op_host"
+    if [[ ! -f "$src" ]]; then
+        log_error "基准测试源文件不存在: $src (请先执行 python3 workflow.py -n ${op_name} --bench)"
+        return 1
+    fi
+
+    local flags_info
+    if ! flags_info=$(extract_compile_flags "/mc2/${op_name}/tests/ut/op_host/test_${op_name}_tiling\.cpp$"); then
+        log_error "compile_commands.json 中没有 ${op_name} 的 UT 编译记录"
+        return 1
+    fi
+    local compiler=$(echo "$flags_info" | sed -n 1p)
+    local flags=$(echo "$flags_info" | sed -n 2p)
+
+    local obj_dir="${BENCH_DIR}/obj"
+    mkdir -p "$obj_dir"
+    local scratch_dir=$(mktemp -d "${TMPDIR:-/tmp}/utgen_bench.XXXXXX")
+    cp "$src" "$scratch_dir/"
+
+    local status=0
+    local stop_flag
+    if ! stop_flag=$(benchmark_stop_flag "$compiler" "$flags" "$scratch_dir/utgen_bench_probe.cpp"); then
+        log_error "需要 Google Benchmark >= 1.6 (可通过 BENCHMARK_ROOT 指定安装目录)"
+        rm -rf "$scratch_dir"
+        return 1
+    fi
+
+    log_info "编译基准测试: ${op_name}"
+    eval "$compiler $flags $(benchmark_flags) -I\"$ut_dir\" -I\"$UTGEN_INCLUDE_DIR\" -c \"$scratch_dir/bench_${op_name}_tiling.cpp\" -o \"$obj_dir/bench_${op_name}_tiling.o\"" || status=$?
+    rm -rf "$scratch_dir"
+    if [[ $status -ne 0 ]]; then
+        log_error "${op_name} 基准测试编译失败"
+        return $status
+    fi
+    # 入口与 benchmark 版本相关，总是重新编译 (单个小文件)
+    eval "$compiler $flags $(benchmark_flags) $stop_flag -c \"${UTGEN_INCLUDE_DIR}/utgen_bench_main.cpp\" -o \"$obj_dir/utgen_bench_main.o\"" || return $?
+
+    (
+        cd "$BUILD_DIR/tests/ut/framework_normal/op_host"
+        eval "$(ut_link_command "$BENCH_DIR/bench_${op_name}_tiling") \"$obj_dir/bench_${op_name}_tiling.o\" \"$obj_dir/utgen_bench_main.o\" $(benchmark_libs)"
+    ) || return $?
+    log_info "基准测试已生成: $BENCH_DIR/bench_${op_name}_tiling"
+}
+
+main() {
+    local command="$1"
+    shift || true
+
+    case "$command" in
+        build)
+            if [[ $# -eq 0 ]]; then
+                log_error "请指定要编译的算子名称"
+                exit 1
+            fi
+            check_compile_commands
+            check_ut_link_txt
+            local failed=0
+            for op_name in "$@"; do
+                build_bench "$op_name" || failed=1
+            done
+            exit $failed
+            ;;
+        run)
+            local op_name="$1"
+            shift || true
+            local bin="${BENCH_DIR}/bench_${op_name}_tiling"
+            if [[ ! -x "$bin" ]]; then
+                log_error "基准测试不存在: $bin，请先执行 $0 build ${op_name}"
+                exit 1
+            fi
+            cd "${OPS_TRANSFORMER_DIR}"
+            export BUILD_PATH="${BUILD_DIR}"
+            exec "$bin" "$@"
+            ;;
+        *)
+            echo "用法: $0 {build <op>...|run <op> [benchmark 参数...]}"
+            exit 1
+            ;;
+    esac
+}
+
+main "$@"
@@ -0,0 +1,129 @@
+#!/bin/bash
+
+# 脚本功能：编译用例库 (.so) 与常驻 runner，实现 "生成 -> 编译单个 TU -> 重新执行" 的快速迭代
+# 使用方法:
+#   ./runner/case_lib.sh build-runner          # 编译常驻 runner (只需一次)
+#   ./runner/case_lib.sh build <op> [<op>...]   # 编译指定算子的用例库，runner 会自动重新加载
+#   ./runner/case_lib.sh run [--once]          # 启动 runner，轮询用例库目录
+#
+# 典型流程:
+#   python3 workflow.py -n all_gather_matmul --case-library
+#   ./runner/case_lib.sh build all_gather_matmul
+#
+# 编译参数取自 ops-transformer 构建目录的 compile_commands.json (需先完整执行一次 build.sh -u，
+# 并开启 CMAKE_EXPORT_COMPILE_COMMANDS)；runner 的链接命令取自 transformer_op_host_ut 的 link.txt。
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )"
+source "${SCRIPT_DIR}/ut_build_env.sh"
+
+UTGEN_CASE_LIB_SRC_DIR="${UTGEN_DIR}/outputs/case_lib"
+CASE_LIB_DIR="${UTGEN_CASE_LIB_DIR:-${BUILD_DIR}/utgen_case_lib}"
+RUNNER_BIN="${BUILD_DIR}/utgen_case_runner"
+
+build_runner() {
+    check_compile_commands
+    check_ut_link_txt
+
+    local flags_info
+    if ! flags_info=$(extract_compile_flags "/tests/ut/.*op_host/test_.*_tiling\.cpp$"); then
+        log_error "compile_commands.json 中没有 op_host tiling UT 的编译记录"
+        exit 1
+    fi
+    local compiler=$(echo "$flags_info" | sed -n 1p)
+    local flags=$(echo "$flags_info" | sed -n 2p)
+
+    log_info "编译 runner: $RUNNER_BIN"
+    eval "$compiler $flags -I\"$UTGEN_INCLUDE_DIR\" -c \"$SCRIPT_DIR/utgen_case_runner.cpp\" -o \"$BUILD_DIR/utgen_case_runner.o\""
+    eval "$compiler $flags -fPIC -c \"$SCRIPT_DIR/utgen_alloc_hook.cpp\" -o \"$BUILD_DIR/utgen_alloc_hook.o\""
+
+    # 复用 UT 可执行文件的链接命令：去掉测试用例目标文件与 UT 自带的 main，换成 runner 入口，
+    # 并以 -rdynamic 导出框架符号与分配统计接口供用例库解析
+    cd "$BUILD_DIR/tests/ut/framework_normal/op_host"
+    eval "$(ut_link_command "$RUNNER_BIN") $BUILD_DIR/utgen_case_runner.o $BUILD_DIR/utgen_alloc_hook.o -rdynamic -ldl"
+    log_info "runner 编译完成"
+}
+
+# 编译单个算子的用例库；在 ops 检出之外的临时目录中编译，模板中的相对 include 通过 -I 指向算子 UT 目录解析
+build_case_lib() {
+    local op_name="$1"
+    local src="${UTGEN_CASE_LIB_SRC_DIR}/test_${op_name}_tiling_lib.cpp"
+    local ut_dir="${MC2_DIR}/${op_name}/tests/ut/op_host"
+    if [[ ! -f "$src" ]]; then
+        log_error "用例库源文件不存在: $src (请先执行 python3 workflow.py -n ${op_name} --case-library)"
+        return 1
+    fi
+
+    local flags_info
+    if ! flags_info=$(extract_compile_flags "/mc2/${op_name}/tests/ut/op_host/test_${op_name}_tiling\.cpp$"); then
+        log_error "compile_commands.json 中没有 ${op_name} 的 UT 编译记录"
+        return 1
+    fi
+    local compiler=$(echo "$flags_info" | sed -n 1p)
+    local flags=$(echo "$flags_info" | sed -n 2p)
+
+    # runner 依赖 dlclose 真正卸载旧库，STB_GNU_UNIQUE 符号会让库常驻，必须关闭
+    local no_unique=""
+    if eval "$compiler -fno-gnu-unique -x c++ -fsyntax-only /dev/null" &> /dev/null; then
+        no_unique="-fno-gnu-unique"
+    else
+        log_warn "编译器不支持 -fno-gnu-unique，用例库中的内联静态变量可能阻止 runner 重新加载"
+    fi
+
+    mkdir -p "$CASE_LIB_DIR"
+    local scratch_dir=$(mktemp -d "${TMPDIR:-/tmp}/utgen_case_lib.XXXXXX")
+    cp "$src" "$scratch_dir/"
+
+    # 先写临时文件再 rename，runner 看到的永远是完整的新库
+    local output="${CASE_LIB_DIR}/libutgen_${op_name}_cases.so"
+    local tmp_output="${CASE_LIB_DIR}/.libutgen_${op_name}_cases.so.tmp"
+    log_info "编译用例库: $output"
+    local status=0
+    eval "$compiler $flags -fPIC -shared $no_unique -I\"$ut_dir\" -I\"$UTGEN_INCLUDE_DIR\" \"$scratch_dir/test_${op_name}_tiling_lib.cpp\" -o \"$tmp_output\"" || status=$?
+    rm -rf "$scratch_dir"
+    if [[ $status -ne 0 ]]; then
+        log_error "${op_name} 用例库编译失败"
+        rm -f "$tmp_output"
+        return $status
+    fi
+    mv -f "$tmp_output" "$output"
+}
+
+main() {
+    local command="$1"
+    shift || true
+
+    case "$command" in
+        build-runner)
+            build_runner
+            ;;
+        build)
+            if [[ $# -eq 0 ]]; then
+                log_error "请指定要编译的算子名称"
+                exit 1
+            fi
+            check_compile_commands
+            local failed=0
+            for op_name in "$@"; do
+                build_case_lib "$op_name" || failed=1
+            done
+            exit $failed
+            ;;
+        run)
+            if [[ ! -x "$RUNNER_BIN" ]]; then
+                log_error "runner 不存在，请先执行 $0 build-runner"
+                exit 1
+            fi
+            cd "${OPS_TRANSFORMER_DIR}"
+            export BUILD_PATH="${BUILD_DIR}"
+            exec "$RUNNER_BIN" --lib-dir "$CASE_LIB_DIR" "$@"
+            ;;
+        *)
+            echo "用法: $0 {build-runner|build <op>...|run [--once] [--interval-ms N]}"
+            exit 1
+            ;;
+    esac
+}
+
+main "$@"
@@ -0,0 +1,94 @@
+#!/bin/bash
+
+# 脚本功能：用同一份生成用例 (outputs/*.cpp) 比较两个 ops-transformer 检出的 tiling 结果
+# 使用方法:
+#   ./runner/tiling_ab.sh <ops-transformer-A> <ops-transformer-B> [tiling_ab_diff.py 参数...]
+#
+# 典型流程:
+#   python3 workflow.py
+#   ./runner/tiling_ab.sh /workspace/ops-transformer-dev /workspace/ops-transformer-next --top 20 --json ab.json
+#
+# 每个检出依次: 部署并编译 (deploy_and_test.sh --build-only)，在 UTGEN_TILING_RECORD 与 UTGEN_REPORT_DIR 下
+# 重复运行 tiling 用例，结果写入 ${UTGEN_AB_DIR}/a 与 ${UTGEN_AB_DIR}/b，最后由 utils/tiling_ab_diff.py
+# 逐用例比较 tiling key / block dim / workspace / tiling data 字段 / tiling 耗时，并按代价模型汇总估算 kernel 耗时的变化。
+# gtest 断言失败 (例如 B 侧改了 tiling key) 不中断比较: 退出码写入结果目录的 ut_status，由 tiling_ab_diff.py 一并报告。
+#
+# 环境变量:
+#   UTGEN_AB_DIR          结果目录 (默认 <ops-transformer-B>/build/utgen_ab_report)
+#   UTGEN_AB_REPEAT       每个检出重复运行的次数，tiling 耗时取中位数 (默认 5)
+#   UTGEN_AB_SKIP_BUILD   为 1 时跳过部署与编译，直接运行两侧已编译好的 UT
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )"
+source "${SCRIPT_DIR}/ut_build_env.sh"
+
+UTGEN_AB_DIFF="${UTGEN_DIR}/utils/tiling_ab_diff.py"
+UTGEN_AB_REPEAT="${UTGEN_AB_REPEAT:-5}"
+
+# 检出的显示名: 目录名@commit
+checkout_label() {
+    local dir="$1"
+    local commit=$(git -C "$dir" rev-parse --short HEAD 2>/dev/null || true)
+    echo "$(basename "$dir")${commit:+@${commit}}"
+}
+
+# 在一个检出上编译并运行用例，记录 tiling 结果、耗时与 gtest 退出码到 $2
+run_checkout() {
+    local dir="$1"
+    local out="$2"
+    local ut_binary
+    local ut_status=0
+
+    if [[ "${UTGEN_AB_SKIP_BUILD:-0}" != "1" ]]; then
+        log_info "部署并编译: $dir"
+        OPS_TRANSFORMER_DIR="$dir" bash "${UTGEN_DIR}/deploy_and_test.sh" --build-only
+    fi
+
+    ut_binary=$(find "$dir/build" -name "transformer_op_host_ut" -type f -executable 2>/dev/null | head -1)
+    if [[ -z "$ut_binary" ]]; then
+        log_error "找不到 $dir 的 transformer_op_host_ut 可执行文件"
+        exit 1
+    fi
+
+    rm -rf "$out"
+    mkdir -p "$out"
+    log_info "运行 tiling 用例: $ut_binary (重复 ${UTGEN_AB_REPEAT} 次)"
+    (
+        cd "$dir"
+        BUILD_PATH="$dir/build" UTGEN_TILING_RECORD="$out/tiling.store" UTGEN_REPORT_DIR="$out" \
+            "$ut_binary" --gtest_filter='*Tiling*:-*InferShape*' --gtest_repeat="$UTGEN_AB_REPEAT" \
+            > "$out/ut.log" 2>&1
+    ) || ut_status=$?
+    echo "$ut_status" > "$out/ut_status"
+    if [[ $ut_status -ne 0 ]]; then
+        log_warn "tiling 用例退出码 ${ut_status}，继续比较已记录的结果，详见 $out/ut.log"
+    fi
+}
+
+main() {
+    if [[ $# -lt 2 || "$1" == "-h" || "$1" == "--help" ]]; then
+        echo "用法: $0 <ops-transformer-A> <ops-transformer-B> [tiling_ab_diff.py 参数...]"
+        exit 1
+    fi
+    local dir_a="$( cd "$1" &> /dev/null && pwd )"
+    local dir_b="$( cd "$2" &> /dev/null && pwd )"
+    shift 2
+    for dir in "$dir_a" "$dir_b"; do
+        if [[ -z "$dir" || ! -d "$dir/mc2" ]]; then
+            log_error "不是 ops-transformer 检出: ${dir:-<不存在>}"
+            exit 1
+        fi
+    done
+
+    local ab_dir="${UTGEN_AB_DIR:-${dir_b}/build/utgen_ab_report}"
+    run_checkout "$dir_a" "$ab_dir/a"
+    run_checkout "$dir_b" "$ab_dir/b"
+
+    log_info "比较 tiling 结果: $ab_dir/a -> $ab_dir/b"
+    python3 "$UTGEN_AB_DIFF" "$ab_dir/a" "$ab_dir/b" \
+        --label-a "$(checkout_label "$dir_a")" --label-b "$(checkout_label "$dir_b")" \
+        --ops-transformer-a "$dir_a" --ops-transformer-b "$dir_b" "$@"
+}
+
+main "$@"
@@ -0,0 +1,90 @@
+#!/bin/bash
+
+# runner/*.sh 共用的构建环境：ops-transformer 路径、日志函数，
+# 以及从 compile_commands.json / transformer_op_host_ut 的 link.txt 复用编译与链接参数。
+# 由其它脚本 source，不单独执行。
+
+UTGEN_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )/.." &> /dev/null && pwd )"
+UTGEN_INCLUDE_DIR="${UTGEN_DIR}/template/include"
+OPS_TRANSFORMER_DIR="${OPS_TRANSFORMER_DIR:-/workspace/ops-transformer-dev}"
+MC2_DIR="${OPS_TRANSFORMER_DIR}/mc2"
+BUILD_DIR="${OPS_TRANSFORMER_DIR}/build"
+COMPILE_COMMANDS="${BUILD_DIR}/compile_commands.json"
+UT_LINK_TXT="${BUILD_DIR}/tests/ut/framework_normal/op_host/CMakeFiles/transformer_op_host_ut.dir/link.txt"
+
+# 颜色输出
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # No Color
+
+log_info() {
+    echo -e "${GREEN}[INFO]${NC} $1"
+}
+
+log_warn() {
+    echo -e "${YELLOW}[WARN]${NC} $1"
+}
+
+log_error() {
+    echo -e "${RED}[ERROR]${NC} $1"
+}
+
+check_compile_commands() {
+    if [[ ! -f "$COMPILE_COMMANDS" ]]; then
+        log_error "未找到 $COMPILE_COMMANDS"
+        log_error "请先在 ops-transformer 中执行一次 bash build.sh -u --ophost 并开启 CMAKE_EXPORT_COMPILE_COMMANDS"
+        exit 1
+    fi
+}
+
+check_ut_link_txt() {
+    if [[ ! -f "$UT_LINK_TXT" ]]; then
+        log_error "未找到 $UT_LINK_TXT，请先完整编译一次 transformer_op_host_ut"
+        exit 1
+    fi
+}
+
+# 从 compile_commands.json 中取出与 pattern 匹配的编译单元的编译参数 (去掉 -o/-c 与源文件)
+# 输出两行：编译器路径、编译参数
+extract_compile_flags() {
+    local pattern="$1"
+    python3 - "$COMPILE_COMMANDS" "$pattern" <<'EOF'
+import json
+import re
+import shlex
+import sys
+
+entries = json.load(open(sys.argv[1]))
+pattern = re.compile(sys.argv[2])
+for entry in entries:
+    if not pattern.search(entry["file"]):
+        continue
+    args = entry.get("arguments") or shlex.split(entry["command"])
+    flags = []
+    skip = False
+    for arg in args[1:]:
+        if skip:
+            skip = False
+            continue
+        if arg in ("-o", "-c"):
+            skip = True
+            continue
+        if arg == entry["file"] or arg.endswith(".cpp"):
+            continue
+        flags.append(arg)
+    print(args[0])
+    print(" ".join(shlex.quote(flag) for flag in flags))
+    sys.exit(0)
+sys.exit(1)
+EOF
+}
+
+# 复用 UT 可执行文件的链接命令：去掉测试用例目标文件、UT 自带的 main 与 gtest_main，
+# 输出到 $1；需在 transformer_op_host_ut 的构建目录下执行，调用方再追加自己的目标文件
+ut_link_command() {
+    local output="$1"
+    cat "$UT_LINK_TXT" \
+        | sed -E 's#[^ ]*/tests/ut/op_host/[^ ]*\.o##g; s#[^ ]*/[^ /]*main[^ /]*\.(cpp|cc)\.o##g; s#[^ ]*gtest_main[^ ]*##g' \
+        | sed -E "s#-o +[^ ]*transformer_op_host_ut#-o $output#"
+}
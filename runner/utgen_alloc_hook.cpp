@@ -0,0 +1,189 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 堆分配 hook 库 (实现 utgen_alloc_stats.h 中的接口)
+ *
+ * 链接进可执行文件后，这里的 malloc/free/calloc/realloc/reallocarray/memalign/valloc/pvalloc 等强符号会优先于 glibc 被
+ * 所有共享库 (包括 libstdc++ 的 operator new/delete 与算子 tiling 库) 解析到，
+ * 实际分配转发给 glibc 的 __libc_* 实现。只有处于 UTGenAllocScopeBegin/End 之间的线程计数，
+ * 其余时候只多一次 thread_local 判断。字节数按 malloc_usable_size 计，分配与释放口径一致。
+ * 不经过 malloc 族的内存 (直接 mmap/brk、自带分配器的第三方库) 不在统计范围内。
+ *
+ * 编译: g++ -O2 -fPIC -c runner/utgen_alloc_hook.cpp (见 deploy_and_test.sh --alloc-hook)
+ */
+
+#include <malloc.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#define UTGEN_ALLOC_HOOK_WEAK
+#include "../template/include/utgen_alloc_stats.h"
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void __libc_free(void *ptr);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+}
+
+namespace {
+
+// 平凡类型的 thread_local 不需要构造守卫，不会在 malloc 内部再触发分配
+struct ThreadAllocState {
+    int depth;
+    uint64_t allocs;
+    uint64_t bytes;
+    int64_t liveBytes;
+    int64_t peakLiveBytes;
+};
+
+thread_local ThreadAllocState t_allocState;
+
+inline void OnAlloc(void *ptr)
+{
+    ThreadAllocState &state = t_allocState;
+    if (state.depth == 0 || ptr == nullptr) {
+        return;
+    }
+    const size_t size = malloc_usable_size(ptr);
+    state.allocs += 1;
+    state.bytes += size;
+    state.liveBytes += static_cast<int64_t>(size);
+    if (state.liveBytes > state.peakLiveBytes) {
+        state.peakLiveBytes = state.liveBytes;
+    }
+}
+
+inline void OnFree(void *ptr)
+{
+    ThreadAllocState &state = t_allocState;
+    if (state.depth == 0 || ptr == nullptr) {
+        return;
+    }
+    state.liveBytes -= static_cast<int64_t>(malloc_usable_size(ptr));
+}
+
+} // namespace
+
+extern "C" {
+
+void UTGenAllocScopeBegin(void)
+{
+    ThreadAllocState &state = t_allocState;
+    if (state.depth++ == 0) {
+        state.allocs = 0;
+        state.bytes = 0;
+        state.liveBytes = 0;
+        state.peakLiveBytes = 0;
+    }
+}
+
+void UTGenAllocScopeEnd(UTGenAllocStats *stats)
+{
+    ThreadAllocState &state = t_allocState;
+    if (state.depth > 0) {
+        --state.depth;
+    }
+    if (stats != nullptr) {
+        stats->allocs = state.allocs;
+        stats->bytes = state.bytes;
+        stats->peakLiveBytes = state.peakLiveBytes;
+    }
+}
+
+void *malloc(size_t size)
+{
+    void *ptr = __libc_malloc(size);
+    OnAlloc(ptr);
+    return ptr;
+}
+
+void free(void *ptr)
+{
+    OnFree(ptr);
+    __libc_free(ptr);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    void *ptr = __libc_calloc(count, size);
+    OnAlloc(ptr);
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    // 按 "释放旧块 + 分配新块" 计数；失败时旧块仍有效，需要补回
+    OnFree(ptr);
+    void *result = __libc_realloc(ptr, size);
+    if (result == nullptr && size != 0) {
+        OnAlloc(ptr);
+        return nullptr;
+    }
+    OnAlloc(result);
+    return result;
+}
+
+void *reallocarray(void *ptr, size_t count, size_t size)
+{
+    size_t total;
+    if (__builtin_mul_overflow(count, size, &total)) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    return realloc(ptr, total);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+    void *ptr = __libc_memalign(alignment, size);
+    OnAlloc(ptr);
+    return ptr;
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    return memalign(alignment, size);
+}
+
+void *valloc(size_t size)
+{
+    void *ptr = __libc_valloc(size);
+    OnAlloc(ptr);
+    return ptr;
+}
+
+void *pvalloc(size_t size)
+{
+    void *ptr = __libc_pvalloc(size);
+    OnAlloc(ptr);
+    return ptr;
+}
+
+int posix_memalign(void **result, size_t alignment, size_t size)
+{
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void *ptr = memalign(alignment, size);
+    if (ptr == nullptr) {
+        return ENOMEM;
+    }
+    *result = ptr;
+    return 0;
+}
+
+} // extern "C"
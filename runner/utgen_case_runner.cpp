@@ -0,0 +1,242 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 常驻用例 runner
+ *
+ * 与 transformer_op_host_ut 链接相同的框架与算子库 (见 runner/case_lib.sh build-runner)，
+ * 进程启动时完成一次 gtest、算子注册与平台信息初始化。随后轮询用例库目录，
+ * 对新增或 mtime 变化的 libutgen_<op>_cases.so 执行 dlclose -> dlopen -> UTGenRunCaseLibrary，
+ * 未变化的库不会重复加载或执行。
+ *
+ * 用例库中的函数内 static (Logger / TilingReport / TilingStore 的单例等) 在 GCC 下是 STB_GNU_UNIQUE 符号，
+ * 带这类符号的库 dlclose 后不会真正卸载，再次 dlopen 同一路径拿到的仍是旧映像。因此:
+ *   - case_lib.sh 以 -fno-gnu-unique 编译用例库；
+ *   - 每次加载前把库复制到唯一的临时路径 (mkstemp) 再 dlopen，卸载后删除；
+ *   - dlclose 后用 RTLD_NOLOAD 确认旧映像确实已卸载，加载后用 dladdr 确认入口函数来自本次的副本，
+ *     任一不满足时报错而不是继续执行旧代码 (旧映像中的单例仍会被新库绑定)。
+ *
+ * 用法:
+ *   utgen_case_runner [--lib-dir DIR] [--once] [--interval-ms N]
+ */
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utgen_case_library.h"
+
+namespace {
+
+struct LoadedLibrary {
+    void *handle{nullptr};
+    // 本次加载使用的临时副本，dlclose 后删除
+    std::string loadPath;
+    // 秒 + 纳秒组合，精确识别同一秒内的多次重编
+    int64_t mtimeNs{0};
+};
+
+struct RunnerOptions {
+    std::string libDir{"case_lib"};
+    bool once{false};
+    int intervalMs{500};
+};
+
+bool ParseOptions(int argc, char **argv, RunnerOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--lib-dir") == 0 && i + 1 < argc) {
+            options.libDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--once") == 0) {
+            options.once = true;
+        } else if (std::strcmp(argv[i], "--interval-ms") == 0 && i + 1 < argc) {
+            options.intervalMs = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--lib-dir DIR] [--once] [--interval-ms N]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::map<std::string, int64_t> ScanLibraries(const std::string &libDir)
+{
+    std::map<std::string, int64_t> libraries;
+    DIR *dir = opendir(libDir.c_str());
+    if (dir == nullptr) {
+        return libraries;
+    }
+    while (const dirent *entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.rfind("libutgen_", 0) != 0 || name.size() < 3 || name.compare(name.size() - 3, 3, ".so") != 0) {
+            continue;
+        }
+        const std::string path = libDir + "/" + name;
+        struct stat info {};
+        if (stat(path.c_str(), &info) == 0) {
+            libraries[path] = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+        }
+    }
+    closedir(dir);
+    return libraries;
+}
+
+// 卸载上一次加载的副本，返回旧映像是否确实已从进程中移除
+bool UnloadLibrary(LoadedLibrary &library)
+{
+    bool unloaded = true;
+    if (library.handle != nullptr) {
+        dlclose(library.handle);
+        library.handle = nullptr;
+        // 带 STB_GNU_UNIQUE 符号的库 dlclose 后仍驻留，RTLD_NOLOAD 按路径仍能找到它
+        void *resident = dlopen(library.loadPath.c_str(), RTLD_NOW | RTLD_NOLOAD);
+        if (resident != nullptr) {
+            dlclose(resident);
+            unloaded = false;
+        }
+    }
+    if (!library.loadPath.empty()) {
+        unlink(library.loadPath.c_str());
+        library.loadPath.clear();
+    }
+    return unloaded;
+}
+
+// 把 src 复制到同目录下唯一命名的隐藏文件，返回新路径；失败时返回空串
+std::string CopyToUniquePath(const std::string &src)
+{
+    const size_t slash = src.rfind('/');
+    std::string pattern = (slash == std::string::npos ? std::string(".") : src.substr(0, slash)) +
+                          "/.utgen_load_XXXXXX";
+    std::vector<char> name(pattern.begin(), pattern.end());
+    name.push_back('\0');
+    const int out = mkstemp(name.data());
+    if (out < 0) {
+        return "";
+    }
+    const int in = open(src.c_str(), O_RDONLY);
+    bool ok = in >= 0;
+    char buffer[1 << 16];
+    while (ok) {
+        const ssize_t n = read(in, buffer, sizeof(buffer));
+        if (n <= 0) {
+            ok = n == 0;
+            break;
+        }
+        ok = write(out, buffer, static_cast<size_t>(n)) == n;
+    }
+    if (in >= 0) {
+        close(in);
+    }
+    close(out);
+    if (!ok) {
+        unlink(name.data());
+        return "";
+    }
+    return name.data();
+}
+
+// 加载并执行一个用例库，返回是否全部通过
+bool RunLibrary(const std::string &path, LoadedLibrary &library)
+{
+    if (!UnloadLibrary(library)) {
+        std::fprintf(stderr, "[UTGenRunner] previous image of %s is still resident after dlclose "
+                     "(STB_GNU_UNIQUE symbols); rebuild it with -fno-gnu-unique and restart the runner\n",
+                     path.c_str());
+        return false;
+    }
+    library.loadPath = CopyToUniquePath(path);
+    if (library.loadPath.empty()) {
+        std::fprintf(stderr, "[UTGenRunner] copy %s failed: %s\n", path.c_str(), std::strerror(errno));
+        return false;
+    }
+    // RTLD_LOCAL: 各算子库的匿名命名空间符号互不干扰；框架符号由 runner (-rdynamic) 提供
+    library.handle = dlopen(library.loadPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library.handle == nullptr) {
+        std::fprintf(stderr, "[UTGenRunner] load %s failed: %s\n", path.c_str(), dlerror());
+        UnloadLibrary(library);
+        return false;
+    }
+    auto run = reinterpret_cast<UTGenRunCaseLibraryFunc>(dlsym(library.handle, UTGEN_CASE_LIBRARY_ENTRY));
+    if (run == nullptr) {
+        std::fprintf(stderr, "[UTGenRunner] %s has no %s\n", path.c_str(), UTGEN_CASE_LIBRARY_ENTRY);
+        return false;
+    }
+    // 入口函数必须来自本次加载的副本；旧映像未被卸载时 dladdr 给出的是上一次的临时路径
+    Dl_info info {};
+    if (dladdr(reinterpret_cast<void *>(run), &info) == 0 || info.dli_fname == nullptr ||
+        library.loadPath != info.dli_fname) {
+        std::fprintf(stderr, "[UTGenRunner] %s was not reloaded (entry resolved to %s); "
+                     "rebuild it with -fno-gnu-unique\n",
+                     path.c_str(), info.dli_fname == nullptr ? "unknown" : info.dli_fname);
+        return false;
+    }
+
+    UTGenCaseLibraryResult result{};
+    const auto begin = std::chrono::steady_clock::now();
+    const int status = run(&result);
+    const auto costMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    std::printf("[UTGenRunner] %s: %zu case(s), %zu failure(s), %lld ms\n", path.c_str(), result.caseCount,
+                result.failureCount, static_cast<long long>(costMs));
+    if (status != 0 && result.report != nullptr) {
+        std::printf("%s\n", result.report);
+    }
+    std::fflush(stdout);
+    return status == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    // 初始化 gtest 单例，用例库中的断言与失败截获依赖它
+    testing::InitGoogleTest(&argc, argv);
+    RunnerOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    std::map<std::string, LoadedLibrary> loaded;
+    bool allPassed = true;
+    while (true) {
+        for (const auto &item : ScanLibraries(options.libDir)) {
+            LoadedLibrary &library = loaded[item.first];
+            if (library.mtimeNs == item.second) {
+                continue;
+            }
+            library.mtimeNs = item.second;
+            allPassed = RunLibrary(item.first, library) && allPassed;
+        }
+        if (options.once) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.intervalMs));
+    }
+
+    for (auto &item : loaded) {
+        UnloadLibrary(item.second);
+    }
+    return allPassed ? 0 : 1;
+}
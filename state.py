@@ -19,6 +19,18 @@ class WorkflowState(TypedDict):
     # ========== 步骤4：输出信息 ==========
     output_path: str
 
+    # ========== 生成选项 ==========
+    # 批量执行模式：单个 TEST 遍历全部用例，失败用例汇总上报
+    batched: bool
+    # 用例库模式：导出 C 接口，编译为 .so 后由常驻 runner 热加载
+    case_library: bool
+    # 基准测试模式：每个用例注册为一个 Google Benchmark
+    bench: bool
+    # 通信量标注：用例前写入通信量注释，并在输出文件旁写出 .comm.json 报告
+    annotate_comm: bool
+    # 硬件 profile 展开：逗号分隔的 profile 名，每个用例按各 profile 展开一份，None 表示不展开
+    soc_profiles: Optional[str]
+
 
 def create_initial_state(operator_name: Union[OperatorName, str], operator_type: Union[OpType, str]) -> WorkflowState:
     """
@@ -64,4 +76,9 @@ def create_initial_state(operator_name: Union[OperatorName, str], operator_type:
         def_file_path=str(def_file_path),
         template_file_path=str(template_file_path),
         output_path=str(output_path),
+        batched=False,
+        case_library=False,
+        bench=False,
+        annotate_comm=False,
+        soc_profiles=None,
     )
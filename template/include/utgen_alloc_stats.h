@@ -0,0 +1,87 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * tiling 调用期间的堆分配统计接口
+ *
+ * 实现在 runner/utgen_alloc_hook.cpp：链接进 UT 可执行文件后以强符号替换 malloc/free 等
+ * (operator new/delete 最终也走 malloc)，无需 LD_PRELOAD。这里以弱符号声明，
+ * 未链接 hook 库时 AllocHookAvailable() 为 false，统计与分配预算检查自动跳过。
+ */
+#ifndef UTGEN_ALLOC_STATS_H
+#define UTGEN_ALLOC_STATS_H
+
+#include <cstdint>
+
+// hook 库自身包含本头文件时定义为空，导出强符号
+#ifndef UTGEN_ALLOC_HOOK_WEAK
+#define UTGEN_ALLOC_HOOK_WEAK __attribute__((weak))
+#endif
+
+extern "C" {
+struct UTGenAllocStats {
+    uint64_t allocs;
+    uint64_t bytes;
+    // 作用域内存活字节数的峰值 (相对作用域开始时)
+    int64_t peakLiveBytes;
+};
+
+// 只统计当前线程；嵌套调用时以最外层为准
+UTGEN_ALLOC_HOOK_WEAK void UTGenAllocScopeBegin(void);
+UTGEN_ALLOC_HOOK_WEAK void UTGenAllocScopeEnd(struct UTGenAllocStats *stats);
+}
+
+namespace UTGen {
+
+inline bool AllocHookAvailable()
+{
+    return UTGenAllocScopeBegin != nullptr && UTGenAllocScopeEnd != nullptr;
+}
+
+// RAII 统计作用域，hook 库未链接时为空操作
+class AllocScope {
+public:
+    AllocScope() : active_(AllocHookAvailable())
+    {
+        if (active_) {
+            UTGenAllocScopeBegin();
+        }
+    }
+
+    ~AllocScope()
+    {
+        Stop();
+    }
+
+    // 结束统计并返回结果；未链接 hook 库时返回 false
+    bool Stop(UTGenAllocStats *stats = nullptr)
+    {
+        if (!active_) {
+            return false;
+        }
+        active_ = false;
+        UTGenAllocStats result{};
+        UTGenAllocScopeEnd(&result);
+        if (stats != nullptr) {
+            *stats = result;
+        }
+        return true;
+    }
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+    bool active_;
+};
+
+} // namespace UTGen
+
+#endif // UTGEN_ALLOC_STATS_H
@@ -0,0 +1,129 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * tiling 基准测试支持 (header-only)，配合 workflow.py --bench 生成的 bench_<op>_tiling.cpp 使用
+ *
+ * 生成器把 TestOneParamCase 中的 Mc2ExecuteTestCase / ExecuteTestCase 替换为 UTGen::BenchTiling，
+ * 每个用例注册为一个 benchmark：TilingContextPara 与拓扑 mock 在计时循环外准备一次，循环内只调用 ExecuteTiling。
+ *
+ * 环境变量:
+ *   UTGEN_BENCH_WARMUP_S     每个用例首次运行前的预热时长 (秒)，默认 0.1
+ *   UTGEN_BENCH_REPETITIONS  重复次数，默认 5；控制台只显示 mean/median/stddev 汇总，
+ *                            --benchmark_out 的 JSON 保留每次重复的结果供 utils/perf_gate.py 使用
+ * CPU 绑核与分配统计见 utgen_bench_main.cpp。
+ */
+#ifndef UTGEN_BENCH_H
+#define UTGEN_BENCH_H
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "utgen_tiling_exec.h"
+
+namespace UTGen {
+
+struct BenchContext {
+    benchmark::State *state{nullptr};
+    // 每个用例只在第一次被 benchmark 调用时预热，迭代次数探测与重复运行不再重复预热
+    bool *warmedUp{nullptr};
+};
+
+inline BenchContext &CurrentBenchContext()
+{
+    thread_local BenchContext context;
+    return context;
+}
+
+inline double BenchWarmupSeconds()
+{
+    const char *value = std::getenv("UTGEN_BENCH_WARMUP_S");
+    return value == nullptr ? 0.1 : std::atof(value);
+}
+
+inline int BenchRepetitions()
+{
+    const char *value = std::getenv("UTGEN_BENCH_REPETITIONS");
+    return value == nullptr ? 5 : std::atoi(value);
+}
+
+// 注册一个用例；body 负责构造 TilingContextPara 并调用 BenchTiling
+inline void RegisterTilingBenchmark(const std::string &op, const std::string &caseName, std::function<void()> body)
+{
+    auto warmedUp = std::make_shared<bool>(false);
+    benchmark::RegisterBenchmark((op + "/" + caseName).c_str(),
+                                 [body, warmedUp](benchmark::State &state) {
+                                     CurrentBenchContext() = BenchContext{&state, warmedUp.get()};
+                                     body();
+                                     CurrentBenchContext() = BenchContext{};
+                                 })
+        ->Unit(benchmark::kNanosecond)
+        ->Repetitions(BenchRepetitions())
+        ->DisplayAggregatesOnly(true);
+}
+
+// 拓扑 mock 由调用方在进入前设置好，计时循环内只调用 ExecuteTiling
+inline void BenchTilingLoop(const gert::TilingContextPara &tilingContextPara)
+{
+    BenchContext &context = CurrentBenchContext();
+    benchmark::State &state = *context.state;
+    TilingInfo tilingInfo;
+    // 预期失败的用例只会测到报错路径，不计入基准
+    if (!ExecuteTiling(tilingContextPara, tilingInfo)) {
+        state.SkipWithError("tiling failed");
+        return;
+    }
+    state.SetLabel("tilingKey=" + std::to_string(tilingInfo.tilingKey));
+    if (!*context.warmedUp) {
+        // 预热放在计时循环之外，让缓存、分配器与 tiling 内部的静态初始化进入稳态
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(BenchWarmupSeconds());
+        while (std::chrono::steady_clock::now() < deadline) {
+            TilingInfo warmupInfo;
+            ExecuteTiling(tilingContextPara, warmupInfo);
+        }
+        *context.warmedUp = true;
+    }
+    for (auto _ : state) {
+        TilingInfo loopInfo;
+        benchmark::DoNotOptimize(ExecuteTiling(tilingContextPara, loopInfo));
+    }
+}
+
+// 替换 Mc2ExecuteTestCase：期望值等断言参数在基准模式下忽略
+template <typename... Ignored>
+void BenchTiling(const gert::TilingContextPara &tilingContextPara, const Mc2Hcom::MockValues &mockValues,
+                 Ignored &&...)
+{
+    // mock 在计时循环前设置一次，离开作用域 (循环结束后) 再 Reset
+    ScopedHcomMock mock(mockValues);
+    BenchTilingLoop(tilingContextPara);
+}
+
+// 替换 ExecuteTestCase：拓扑 mock 由原 TEST_P 中的准备代码负责
+template <typename... Ignored>
+void BenchTiling(const gert::TilingContextPara &tilingContextPara, ge::graphStatus, Ignored &&...)
+{
+    BenchTilingLoop(tilingContextPara);
+}
+
+inline void BenchTiling(const gert::TilingContextPara &tilingContextPara)
+{
+    BenchTilingLoop(tilingContextPara);
+}
+
+} // namespace UTGen
+
+#endif // UTGEN_BENCH_H
@@ -0,0 +1,171 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * bench_<op>_tiling 可执行文件的入口
+ *
+ * - CPU 绑核: UTGEN_BENCH_CPU 指定 CPU 编号，未设置时绑定到进程启动时所在的 CPU，
+ *   避免调度迁移带来的抖动；设置为 -1 时不绑核。
+ * - 分配统计: 替换全局 operator new/delete 计数，并通过 benchmark::MemoryManager
+ *   在结果中输出每次迭代的分配次数与峰值字节数。需要 Google Benchmark >= 1.6 (Result 含
+ *   total_allocated_bytes/net_heap_growth)；Stop 的签名由 UTGEN_BENCH_STOP_BY_POINTER 选择。
+ */
+
+#include <sched.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct AllocCounters {
+    std::atomic<int64_t> allocs{0};
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+};
+
+AllocCounters g_allocCounters;
+
+// 在每块内存前保存大小，delete 时才能扣减存活字节数
+constexpr size_t kHeader = alignof(std::max_align_t);
+
+void *CountedAlloc(size_t size)
+{
+    void *raw = std::malloc(size + kHeader);
+    if (raw == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t *>(raw) = size;
+    g_allocCounters.allocs.fetch_add(1, std::memory_order_relaxed);
+    g_allocCounters.bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    const int64_t live =
+        g_allocCounters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + size;
+    int64_t peak = g_allocCounters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_allocCounters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return static_cast<char *>(raw) + kHeader;
+}
+
+void CountedFree(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    void *raw = static_cast<char *>(ptr) - kHeader;
+    g_allocCounters.liveBytes.fetch_sub(static_cast<int64_t>(*static_cast<size_t *>(raw)), std::memory_order_relaxed);
+    std::free(raw);
+}
+
+class CountingMemoryManager : public benchmark::MemoryManager {
+public:
+    void Start() override
+    {
+        startAllocs_ = g_allocCounters.allocs.load();
+        startBytes_ = g_allocCounters.bytes.load();
+        startLive_ = g_allocCounters.liveBytes.load();
+        g_allocCounters.peakBytes.store(startLive_);
+    }
+
+#if UTGEN_BENCH_STOP_BY_POINTER
+    // benchmark 1.6/1.7 中 Stop(Result *) 仍为纯虚函数，runner/bench.sh 探测到时定义该宏
+    void Stop(Result *result) override
+    {
+        Fill(*result);
+    }
+#else
+    void Stop(Result &result) override
+    {
+        Fill(result);
+    }
+#endif
+
+private:
+    void Fill(Result &result) const
+    {
+        result.num_allocs = g_allocCounters.allocs.load() - startAllocs_;
+        result.total_allocated_bytes = g_allocCounters.bytes.load() - startBytes_;
+        result.max_bytes_used = g_allocCounters.peakBytes.load() - startLive_;
+        result.net_heap_growth = g_allocCounters.liveBytes.load() - startLive_;
+    }
+
+    int64_t startAllocs_{0};
+    int64_t startBytes_{0};
+    int64_t startLive_{0};
+};
+
+void PinCpu()
+{
+    const char *value = std::getenv("UTGEN_BENCH_CPU");
+    const int cpu = value == nullptr ? sched_getcpu() : std::atoi(value);
+    if (cpu < 0) {
+        return;
+    }
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+        std::fprintf(stderr, "[UTGenBench] pin to cpu %d failed\n", cpu);
+        return;
+    }
+    std::fprintf(stderr, "[UTGenBench] pinned to cpu %d\n", cpu);
+}
+
+} // namespace
+
+void *operator new(size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void *operator new[](size_t size)
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    CountedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    CountedFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    CountedFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    CountedFree(ptr);
+}
+
+int main(int argc, char **argv)
+{
+    PinCpu();
+    static CountingMemoryManager memoryManager;
+    benchmark::RegisterMemoryManager(&memoryManager);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+    return 0;
+}
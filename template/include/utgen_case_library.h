@@ -0,0 +1,40 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 用例库 (case library) 与常驻 runner 之间的 C 接口
+ *
+ * workflow.py --case-library 生成的翻译单元编译为 libutgen_<op>_cases.so，
+ * 导出 UTGenRunCaseLibrary；runner/utgen_case_runner 以 dlopen 加载并调用，
+ * 框架与算子注册信息驻留在 runner 进程中，重新生成后只需重编并重新加载对应 .so。
+ */
+#ifndef UTGEN_CASE_LIBRARY_H
+#define UTGEN_CASE_LIBRARY_H
+
+#include <cstddef>
+
+#define UTGEN_CASE_LIBRARY_EXPORT __attribute__((visibility("default")))
+#define UTGEN_CASE_LIBRARY_ENTRY "UTGenRunCaseLibrary"
+
+extern "C" {
+
+struct UTGenCaseLibraryResult {
+    size_t caseCount;
+    size_t failureCount;
+    // 汇总报告，在库被 dlclose 之前有效
+    const char *report;
+};
+
+// 返回 0 表示全部用例通过
+typedef int (*UTGenRunCaseLibraryFunc)(UTGenCaseLibraryResult *result);
+
+}
+
+#endif // UTGEN_CASE_LIBRARY_H
@@ -0,0 +1,306 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * UTGen 生成用例使用的轻量日志组件 (header-only)
+ *
+ * 环境变量:
+ *   UTGEN_LOG_LEVEL  日志级别: debug / info / warn / error / off，默认 off (静默)
+ *   UTGEN_LOG_FILE   输出文件路径，不设置时输出到 stderr
+ *   UTGEN_LOG_ASYNC  设置为 1 时由后台线程落盘，用例线程只负责写入内存缓冲
+ *
+ * 用法:
+ *   UTGEN_LOG(INFO) << "AllGatherMatmulTiling SetUp";
+ *   UTGEN_LOG(DEBUG).With("case", param.case_name) << "run case";
+ *
+ * 级别未开启时流表达式不会被求值；输出为 logfmt 格式的单行记录，
+ * 经内存缓冲后批量写出，进程退出时自动刷新。
+ */
+#ifndef UTGEN_LOG_H
+#define UTGEN_LOG_H
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace UTGen {
+
+// 枚举值带 k 前缀：部分平台头文件 (wingdi.h、glog 兼容层等) 把 ERROR 等定义为宏
+enum class LogLevel : int {
+    kDebug = 0,
+    kInfo = 1,
+    kWarn = 2,
+    kError = 3,
+    kOff = 4,
+};
+
+// UTGEN_LOG(INFO) 中的级别名经 ## 拼接为以下常量；## 的操作数不做宏展开，ERROR 宏不影响 UTGEN_LOG(ERROR)
+constexpr LogLevel kLogLevel_DEBUG = LogLevel::kDebug;
+constexpr LogLevel kLogLevel_INFO = LogLevel::kInfo;
+constexpr LogLevel kLogLevel_WARN = LogLevel::kWarn;
+constexpr LogLevel kLogLevel_ERROR = LogLevel::kError;
+
+inline const char *LogLevelName(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::kDebug:
+            return "DEBUG";
+        case LogLevel::kInfo:
+            return "INFO";
+        case LogLevel::kWarn:
+            return "WARN";
+        case LogLevel::kError:
+            return "ERROR";
+        default:
+            return "OFF";
+    }
+}
+
+inline LogLevel ParseLogLevel(const char *text)
+{
+    if (text == nullptr) {
+        return LogLevel::kOff;
+    }
+    std::string value(text);
+    for (char &c : value) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (value == "debug") {
+        return LogLevel::kDebug;
+    }
+    if (value == "info") {
+        return LogLevel::kInfo;
+    }
+    if (value == "warn" || value == "warning") {
+        return LogLevel::kWarn;
+    }
+    if (value == "error") {
+        return LogLevel::kError;
+    }
+    return LogLevel::kOff;
+}
+
+class Logger {
+public:
+    static Logger &Instance()
+    {
+        static Logger instance;
+        return instance;
+    }
+
+    bool Enabled(LogLevel level) const
+    {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    // 初始级别为 off 时输出端尚未打开，运行中开启日志时在这里按环境变量打开
+    void SetLevel(LogLevel level)
+    {
+        if (level < LogLevel::kOff) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            OpenSinkLocked();
+        }
+        level_.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    void Write(const std::string &record)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (sink_ == nullptr) {
+            // 没有输出端时直接丢弃，避免记录在 pending_ 中无限堆积
+            return;
+        }
+        pending_ += record;
+        if (pending_.size() < kFlushThreshold) {
+            return;
+        }
+        if (async_) {
+            lock.unlock();
+            wakeup_.notify_one();
+            return;
+        }
+        FlushLocked();
+    }
+
+    void Flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FlushLocked();
+    }
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+private:
+    static constexpr size_t kFlushThreshold = 64 * 1024;
+
+    Logger() : level_(static_cast<int>(ParseLogLevel(std::getenv("UTGEN_LOG_LEVEL"))))
+    {
+        if (level_.load() >= static_cast<int>(LogLevel::kOff)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        OpenSinkLocked();
+    }
+
+    void OpenSinkLocked()
+    {
+        if (sink_ != nullptr) {
+            return;
+        }
+        const char *path = std::getenv("UTGEN_LOG_FILE");
+        if (path != nullptr && path[0] != '\0') {
+            sink_ = std::fopen(path, "a");
+        }
+        if (sink_ == nullptr) {
+            sink_ = stderr;
+        }
+        const char *async = std::getenv("UTGEN_LOG_ASYNC");
+        async_ = async != nullptr && std::strcmp(async, "1") == 0;
+        if (async_) {
+            worker_ = std::thread([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~Logger()
+    {
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wakeup_.notify_one();
+            worker_.join();
+        }
+        Flush();
+        if (sink_ != nullptr && sink_ != stderr) {
+            std::fclose(sink_);
+        }
+    }
+
+    void FlushLocked()
+    {
+        if (pending_.empty() || sink_ == nullptr) {
+            return;
+        }
+        std::fwrite(pending_.data(), 1, pending_.size(), sink_);
+        std::fflush(sink_);
+        pending_.clear();
+    }
+
+    void WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            wakeup_.wait_for(lock, std::chrono::milliseconds(200));
+            if (pending_.empty()) {
+                continue;
+            }
+            // 交换缓冲区后在锁外写出，避免阻塞用例线程
+            std::string batch;
+            batch.swap(pending_);
+            lock.unlock();
+            std::fwrite(batch.data(), 1, batch.size(), sink_);
+            std::fflush(sink_);
+            lock.lock();
+        }
+    }
+
+    std::atomic<int> level_;
+    std::FILE *sink_{nullptr};
+    bool async_{false};
+    bool stop_{false};
+    std::string pending_;
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::thread worker_;
+};
+
+// 单条日志记录，析构时格式化为一行 logfmt 写入 Logger
+class LogRecord {
+public:
+    LogRecord(LogLevel level, const char *file, int line) : level_(level), file_(file), line_(line) {}
+
+    ~LogRecord()
+    {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const char *base = std::strrchr(file_, '/');
+        std::ostringstream record;
+        record << "ts_us=" << std::chrono::duration_cast<std::chrono::microseconds>(now).count()
+               << " level=" << LogLevelName(level_)
+               << " src=" << (base == nullptr ? file_ : base + 1) << ":" << line_
+               << fields_.str()
+               << " msg=\"" << Escape(message_.str()) << "\"\n";
+        Logger::Instance().Write(record.str());
+    }
+
+    template <typename T>
+    LogRecord &With(const char *key, const T &value)
+    {
+        std::ostringstream text;
+        text << value;
+        fields_ << " " << key << "=\"" << Escape(text.str()) << "\"";
+        return *this;
+    }
+
+    std::ostringstream &stream()
+    {
+        return message_;
+    }
+
+    template <typename T>
+    std::ostringstream &operator<<(const T &value)
+    {
+        message_ << value;
+        return message_;
+    }
+
+private:
+    static std::string Escape(const std::string &text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (c == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    LogLevel level_;
+    const char *file_;
+    int line_;
+    std::ostringstream fields_;
+    std::ostringstream message_;
+};
+
+} // namespace UTGen
+
+#define UTGEN_LOG(level)                                                      \
+    if (!::UTGen::Logger::Instance().Enabled(::UTGen::kLogLevel_##level)) {   \
+    } else                                                                    \
+        ::UTGen::LogRecord(::UTGen::kLogLevel_##level, __FILE__, __LINE__)
+
+#endif // UTGEN_LOG_H
@@ -0,0 +1,145 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 用例级 tiling 耗时预算 (header-only)
+ *
+ * JSONL 用例中的 maxTilingLatencyUs (或算子级 {"defaults": {...}} 记录中的默认值) 由生成器
+ * 渲染到参数结构体的 budget 成员；TestOneParamCase 末尾调用:
+ *   UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
+ * 预热若干次后取多次 tiling 耗时的中位数，超过预算时用例失败。未设置预算的用例不做额外执行。
+ * 通信拓扑 mock 在整个预热与测量过程中只注入一次，计时与分配统计只覆盖 tiling 本身。
+ *
+ * maxTilingAllocs / maxTilingAllocBytes 限制预热后单次 tiling 的堆分配次数与字节数，
+ * 需要 UT 可执行文件链接分配 hook 库 (见 utgen_alloc_stats.h)，未链接时只告警不检查。
+ *
+ * 环境变量:
+ *   UTGEN_BUDGET_WARMUP  预热次数，默认 3
+ *   UTGEN_BUDGET_RUNS    计时次数，默认 5
+ *   UTGEN_BUDGET_SCALE   预算放大系数，默认 1.0 (慢速或共享的 CI 机器上可调大)
+ */
+#ifndef UTGEN_TILING_BUDGET_H
+#define UTGEN_TILING_BUDGET_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utgen_alloc_stats.h"
+#include "utgen_log.h"
+#include "utgen_tiling_exec.h"
+#include "utgen_tiling_probe.h"
+
+namespace UTGen {
+
+struct TilingBudget {
+    // 0 表示不限制
+    double maxTilingLatencyUs{0};
+    uint64_t maxTilingAllocs{0};
+    uint64_t maxTilingAllocBytes{0};
+};
+
+inline int BudgetEnvInt(const char *name, int defaultValue)
+{
+    const char *value = std::getenv(name);
+    return value == nullptr ? defaultValue : std::max(1, std::atoi(value));
+}
+
+inline double TilingBudgetScale()
+{
+    const char *value = std::getenv("UTGEN_BUDGET_SCALE");
+    return value == nullptr ? 1.0 : std::atof(value);
+}
+
+// 预热与测量前注入一次拓扑 mock (处于 HcomMockBatch 内时交给批次)，非 MC2 用例不注入
+inline std::unique_ptr<ScopedHcomMock> BudgetHcomMock()
+{
+    return nullptr;
+}
+
+inline std::unique_ptr<ScopedHcomMock> BudgetHcomMock(const Mc2Hcom::MockValues &mockValues)
+{
+    return std::unique_ptr<ScopedHcomMock>(new ScopedHcomMock(mockValues));
+}
+
+inline void ExpectTilingLatencyWithinBudget(const TilingBudget &budget,
+                                            const gert::TilingContextPara &tilingContextPara)
+{
+    const int runs = BudgetEnvInt("UTGEN_BUDGET_RUNS", 5);
+    std::vector<int64_t> durations;
+    durations.reserve(runs);
+    for (int i = 0; i < runs; ++i) {
+        TilingInfo tilingInfo;
+        const int64_t start = MonotonicNs();
+        RunTiling(tilingContextPara, tilingInfo);
+        durations.push_back(MonotonicNs() - start);
+    }
+    std::nth_element(durations.begin(), durations.begin() + runs / 2, durations.end());
+    const double medianUs = durations[runs / 2] / 1000.0;
+    const double limitUs = budget.maxTilingLatencyUs * TilingBudgetScale();
+    EXPECT_LE(medianUs, limitUs) << "tiling latency over budget: median " << medianUs << " us of " << runs
+                                 << " runs > maxTilingLatencyUs " << limitUs;
+}
+
+inline void ExpectTilingAllocsWithinBudget(const TilingBudget &budget,
+                                           const gert::TilingContextPara &tilingContextPara)
+{
+    if (!AllocHookAvailable()) {
+        UTGEN_LOG(WARN) << "allocation budget set but alloc hook library is not linked, skipped";
+        return;
+    }
+    UTGenAllocStats stats{};
+    {
+        TilingInfo tilingInfo;
+        AllocScope scope;
+        RunTiling(tilingContextPara, tilingInfo);
+        scope.Stop(&stats);
+    }
+    if (budget.maxTilingAllocs > 0) {
+        EXPECT_LE(stats.allocs, budget.maxTilingAllocs) << "tiling allocations over budget";
+    }
+    if (budget.maxTilingAllocBytes > 0) {
+        EXPECT_LE(stats.bytes, budget.maxTilingAllocBytes)
+            << "tiling allocated bytes over budget (peak live " << stats.peakLiveBytes << " bytes)";
+    }
+}
+
+template <typename... MockArgs>
+void ExpectTilingWithinBudget(TilingProbe &probe, const TilingBudget &budget,
+                              const gert::TilingContextPara &tilingContextPara, const MockArgs &...mockValues)
+{
+    probe.Stop();
+    const bool checkLatency = budget.maxTilingLatencyUs > 0;
+    const bool checkAllocs = budget.maxTilingAllocs > 0 || budget.maxTilingAllocBytes > 0;
+    if (!checkLatency && !checkAllocs) {
+        return;
+    }
+
+    const auto mock = BudgetHcomMock(mockValues...);
+    // 预热让 tiling 内部的缓存与静态初始化进入稳态，之后的耗时与分配才有代表性
+    const int warmup = BudgetEnvInt("UTGEN_BUDGET_WARMUP", 3);
+    for (int i = 0; i < warmup; ++i) {
+        TilingInfo tilingInfo;
+        RunTiling(tilingContextPara, tilingInfo);
+    }
+    if (checkLatency) {
+        ExpectTilingLatencyWithinBudget(budget, tilingContextPara);
+    }
+    if (checkAllocs) {
+        ExpectTilingAllocsWithinBudget(budget, tilingContextPara);
+    }
+}
+
+} // namespace UTGen
+
+#endif // UTGEN_TILING_BUDGET_H
@@ -0,0 +1,72 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * tiling 结果采集 (header-only)
+ *
+ * Mc2ExecuteTestCase / ExecuteTestCase 只校验调用方给出的期望值，workspace 与 tiling data 长度
+ * 在大多数模板中没有被检查。TestOneParamCase 末尾调用:
+ *   UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+ * 在 UTGEN_REPORT_DIR 设置时额外执行一次 tiling，把 tiling key、block dim、workspace、实际使用的
+ * tiling data 长度与用例预留的长度写入 tiling_results.json，供 utils/workspace_golden.py 与 golden 文件比对、
+ * utils/tiling_data_usage.py 统计 tiling data 利用率。
+ * 设置 UTGEN_TILING_RECORD / UTGEN_TILING_VERIFY 时同时记录或校验完整的 tiling 结果 (见 utgen_tiling_store.h)。
+ */
+#ifndef UTGEN_TILING_CAPTURE_H
+#define UTGEN_TILING_CAPTURE_H
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utgen_tiling_exec.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_store.h"
+
+namespace UTGen {
+
+template <typename... MockArgs>
+void CaptureTilingResult(TilingProbe &probe, const gert::TilingContextPara &tilingContextPara,
+                         const MockArgs &...mockValues)
+{
+    probe.Stop();
+    TilingReport &report = TilingReport::Instance();
+    TilingStore &store = TilingStore::Instance();
+    if (!report.Enabled() && !store.Active()) {
+        return;
+    }
+    TilingInfo tilingInfo;
+    TilingResult result;
+    result.op = probe.Op();
+    result.caseName = probe.CaseName();
+    result.tilingDataCapacity = TilingDataCapacity(tilingContextPara);
+    result.success = RunTiling(tilingContextPara, mockValues..., tilingInfo);
+    if (result.success) {
+        result.tilingKey = static_cast<int64_t>(tilingInfo.tilingKey);
+        result.blockDim = static_cast<int64_t>(tilingInfo.blockNum);
+        result.workspaces.assign(tilingInfo.workspaceSizes.begin(), tilingInfo.workspaceSizes.end());
+        result.tilingDataSize = tilingInfo.tilingDataSize;
+    }
+    const std::string caseId = result.op + "/" + result.caseName;
+    if (store.Recording() && result.success) {
+        store.Record(caseId, tilingInfo);
+    }
+    if (store.Verifying()) {
+        const std::string diff = store.Verify(caseId, result.success, tilingInfo);
+        EXPECT_TRUE(diff.empty()) << "tiling result differs from store for " << caseId << ": " << diff;
+    }
+    if (report.Enabled()) {
+        report.AddResult(std::move(result));
+    }
+}
+
+} // namespace UTGen
+
+#endif // UTGEN_TILING_CAPTURE_H
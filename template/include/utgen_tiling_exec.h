@@ -0,0 +1,197 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 直接执行 tiling 并取回结果的薄封装 (header-only)
+ *
+ * Mc2ExecuteTestCase / ExecuteTestCase 只做断言、不返回 tiling 结果；
+ * 基准测试与结果采集需要拿到 tiling key、block dim、workspace 与 tiling data，
+ * 统一通过这里调用框架的 ExecuteTiling，避免各处直接依赖 TilingInfo 的字段布局。
+ * 通信拓扑 mock 通过 ScopedHcomMock 注入；批量执行 (workflow.py --batched / --case-library) 时
+ * 由 HcomMockBatch 在整批用例外层统一设置与复位。
+ * 按硬件 profile 展开 (workflow.py --soc-profiles) 时，非原 SoC 的用例登记为只记录结果 (RecordOnlyCases)，
+ * 生成器把断言调用改为 ProfileMc2ExecuteTestCase / ProfileExecuteTestCase，这些用例只执行 tiling。
+ */
+#ifndef UTGEN_TILING_EXEC_H
+#define UTGEN_TILING_EXEC_H
+
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "mc2_tiling_case_executor.h"
+
+namespace UTGen {
+
+// 单次 tiling，返回 tiling 函数是否执行成功
+inline bool RunTiling(const gert::TilingContextPara &tilingContextPara, TilingInfo &tilingInfo)
+{
+    return ExecuteTiling(tilingContextPara, tilingInfo);
+}
+
+// 一批用例共用的通信拓扑 mock：批量执行入口在遍历用例表前构造，批内 mock 值与上次相同时不再重复 SetValues，
+// 析构时 Reset 一次。同一时刻只有一个批次生效，批外的调用各自 SetValues / Reset。
+class HcomMockBatch {
+public:
+    HcomMockBatch() : previous_(Active())
+    {
+        Active() = this;
+    }
+
+    ~HcomMockBatch()
+    {
+        Active() = previous_;
+        if (applied_) {
+            Mc2Hcom::MC2HcomTopologyMocker::GetInstance().Reset();
+        }
+    }
+
+    HcomMockBatch(const HcomMockBatch &) = delete;
+    HcomMockBatch &operator=(const HcomMockBatch &) = delete;
+
+    static HcomMockBatch *Current()
+    {
+        return Active();
+    }
+
+    void Apply(const Mc2Hcom::MockValues &mockValues)
+    {
+        if (applied_ && mockValues == current_) {
+            return;
+        }
+        Mc2Hcom::MC2HcomTopologyMocker::GetInstance().SetValues(mockValues);
+        current_ = mockValues;
+        applied_ = true;
+    }
+
+private:
+    static HcomMockBatch *&Active()
+    {
+        static HcomMockBatch *active = nullptr;
+        return active;
+    }
+
+    HcomMockBatch *previous_;
+    Mc2Hcom::MockValues current_;
+    bool applied_{false};
+};
+
+// 单次 tiling 期间注入 mock 值；处于 HcomMockBatch 内时交给批次管理，不在每次调用后 Reset
+class ScopedHcomMock {
+public:
+    explicit ScopedHcomMock(const Mc2Hcom::MockValues &mockValues) : batch_(HcomMockBatch::Current())
+    {
+        if (batch_ != nullptr) {
+            batch_->Apply(mockValues);
+        } else {
+            Mc2Hcom::MC2HcomTopologyMocker::GetInstance().SetValues(mockValues);
+        }
+    }
+
+    ~ScopedHcomMock()
+    {
+        if (batch_ == nullptr) {
+            Mc2Hcom::MC2HcomTopologyMocker::GetInstance().Reset();
+        }
+    }
+
+    ScopedHcomMock(const ScopedHcomMock &) = delete;
+    ScopedHcomMock &operator=(const ScopedHcomMock &) = delete;
+
+private:
+    HcomMockBatch *batch_;
+};
+
+// MC2 算子需要在 tiling 期间注入通信拓扑 mock 值，与 Mc2ExecuteTestCase 的行为保持一致
+inline bool RunTiling(const gert::TilingContextPara &tilingContextPara, const Mc2Hcom::MockValues &mockValues,
+                      TilingInfo &tilingInfo)
+{
+    ScopedHcomMock mock(mockValues);
+    return ExecuteTiling(tilingContextPara, tilingInfo);
+}
+
+// 批量模式下替换 Mc2ExecuteTestCase：断言参数原样交给 ExecuteTestCase，mock 由所在的 HcomMockBatch 管理
+template <typename... ExpectArgs>
+void BatchedMc2ExecuteTestCase(const gert::TilingContextPara &tilingContextPara,
+                               const Mc2Hcom::MockValues &mockValues, ExpectArgs &&...expectArgs)
+{
+    ScopedHcomMock mock(mockValues);
+    ExecuteTestCase(tilingContextPara, std::forward<ExpectArgs>(expectArgs)...);
+}
+
+// 不带期望值的 Mc2ExecuteTestCase 默认期望 tiling 失败
+inline void BatchedMc2ExecuteTestCase(const gert::TilingContextPara &tilingContextPara,
+                                      const Mc2Hcom::MockValues &mockValues)
+{
+    BatchedMc2ExecuteTestCase(tilingContextPara, mockValues, ge::GRAPH_FAILED);
+}
+
+// 没有当前硬件上期望值的用例 (按非原 SoC 的 profile 展开)，结果由 CaptureTilingResult 记录
+class RecordOnlyCases {
+public:
+    static RecordOnlyCases &Instance()
+    {
+        static RecordOnlyCases instance;
+        return instance;
+    }
+
+    bool Register(std::initializer_list<const char *> caseNames)
+    {
+        names_.insert(caseNames.begin(), caseNames.end());
+        return true;
+    }
+
+    bool Contains(const std::string &caseName) const
+    {
+        return names_.count(caseName) != 0;
+    }
+
+private:
+    std::set<std::string> names_;
+};
+
+// 替换 Mc2ExecuteTestCase：只记录结果的用例执行一次 tiling，不做断言；批量执行时交给 HcomMockBatch 管理 mock
+template <typename... ExpectArgs>
+void ProfileMc2ExecuteTestCase(const std::string &caseName, const gert::TilingContextPara &tilingContextPara,
+                               const Mc2Hcom::MockValues &mockValues, ExpectArgs &&...expectArgs)
+{
+    if (RecordOnlyCases::Instance().Contains(caseName)) {
+        TilingInfo tilingInfo;
+        RunTiling(tilingContextPara, mockValues, tilingInfo);
+    } else if (HcomMockBatch::Current() != nullptr) {
+        BatchedMc2ExecuteTestCase(tilingContextPara, mockValues, std::forward<ExpectArgs>(expectArgs)...);
+    } else {
+        Mc2ExecuteTestCase(tilingContextPara, mockValues, std::forward<ExpectArgs>(expectArgs)...);
+    }
+}
+
+// 替换 ExecuteTestCase：拓扑 mock 由原 TEST_P 中的准备代码负责
+template <typename... ExpectArgs>
+void ProfileExecuteTestCase(const std::string &caseName, const gert::TilingContextPara &tilingContextPara,
+                            ExpectArgs &&...expectArgs)
+{
+    if (RecordOnlyCases::Instance().Contains(caseName)) {
+        TilingInfo tilingInfo;
+        RunTiling(tilingContextPara, tilingInfo);
+    } else {
+        ExecuteTestCase(tilingContextPara, std::forward<ExpectArgs>(expectArgs)...);
+    }
+}
+
+// 用例为 tiling data 预留的字节数 (构造 TilingContextPara 时传入的 tilingDataSize)
+inline uint64_t TilingDataCapacity(const gert::TilingContextPara &tilingContextPara)
+{
+    return static_cast<uint64_t>(tilingContextPara.tilingDataSize_);
+}
+
+} // namespace UTGen
+
+#endif // UTGEN_TILING_EXEC_H
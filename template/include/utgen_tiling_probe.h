@@ -0,0 +1,352 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * 生成用例的 tiling 耗时探针 (header-only)
+ *
+ * 在 TestOneParamCase 中包住 Mc2ExecuteTestCase / ExecuteTestCase 调用:
+ *   UTGen::TilingProbe probe("AllGatherMatmul", param.case_name, param.expectTilingKey);
+ *   ExecuteTestCase(tilingContextPara, ge::GRAPH_SUCCESS, param.expectTilingKey);
+ * 探针析构时以单调时钟记录耗时；UT 可执行文件链接了分配 hook 库 (runner/utgen_alloc_hook.cpp) 时，
+ * 同时记录探针作用域内的分配次数、字节数与存活字节峰值。
+ *
+ * 环境变量:
+ *   UTGEN_REPORT_DIR  设置后启用记录，测试程序结束时写出
+ *                     tiling_latency.json (case/op/tilingKey/ns/allocs/allocBytes/peakLiveBytes) 与
+ *                     tiling_trace.json (Chrome trace 格式，可直接用 Perfetto / chrome://tracing 打开)，
+ *                     以及 CaptureTilingResult 采集的 tiling_results.json (见 utgen_tiling_capture.h)
+ * 未设置时探针只保存算子名与用例名，不计时。
+ */
+#ifndef UTGEN_TILING_PROBE_H
+#define UTGEN_TILING_PROBE_H
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utgen_alloc_stats.h"
+
+namespace UTGen {
+
+struct TilingSample {
+    std::string op;
+    std::string caseName;
+    std::string testName;
+    // 用例期望的 tiling key，失败用例等没有期望 key 时为空
+    bool hasTilingKey{false};
+    uint64_t tilingKey{0};
+    int64_t startNs{0};
+    int64_t durationNs{0};
+    uint32_t tid{0};
+    // 未链接分配 hook 库时为空
+    bool hasAllocStats{false};
+    UTGenAllocStats allocStats{};
+};
+
+// 一次 tiling 的产出：tiling key、block dim、workspace 与实际使用的 tiling data 长度
+struct TilingResult {
+    std::string op;
+    std::string caseName;
+    bool success{false};
+    int64_t tilingKey{-1};
+    int64_t blockDim{-1};
+    std::vector<int64_t> workspaces;
+    size_t tilingDataSize{0};
+    // 用例预留的 tiling data 字节数，用于统计利用率
+    uint64_t tilingDataCapacity{0};
+};
+
+inline int64_t MonotonicNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline std::string TilingKeyJson(const TilingSample &sample)
+{
+    return sample.hasTilingKey ? std::to_string(sample.tilingKey) : "null";
+}
+
+inline std::string AllocStatsJson(const TilingSample &sample)
+{
+    if (!sample.hasAllocStats) {
+        return "\"allocs\": null, \"allocBytes\": null, \"peakLiveBytes\": null";
+    }
+    return "\"allocs\": " + std::to_string(sample.allocStats.allocs) +
+           ", \"allocBytes\": " + std::to_string(sample.allocStats.bytes) +
+           ", \"peakLiveBytes\": " + std::to_string(sample.allocStats.peakLiveBytes);
+}
+
+inline std::string JsonEscape(const std::string &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(c));
+            escaped += buf;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// 进程内所有探针样本的汇总，测试程序结束 (或进程退出) 时写出报告
+class TilingReport {
+public:
+    static TilingReport &Instance()
+    {
+        static TilingReport instance;
+        return instance;
+    }
+
+    bool Enabled() const
+    {
+        return !reportDir_.empty();
+    }
+
+    const std::string &ReportDir() const
+    {
+        return reportDir_;
+    }
+
+    void Add(TilingSample sample)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_.push_back(std::move(sample));
+        dirty_ = true;
+    }
+
+    void AddResult(TilingResult result)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.push_back(std::move(result));
+        dirty_ = true;
+    }
+
+    void Write()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!Enabled() || !dirty_) {
+            return;
+        }
+        WriteLatencyReport();
+        WriteTrace();
+        WriteResults();
+        dirty_ = false;
+    }
+
+    TilingReport(const TilingReport &) = delete;
+    TilingReport &operator=(const TilingReport &) = delete;
+
+private:
+    TilingReport()
+    {
+        const char *dir = std::getenv("UTGEN_REPORT_DIR");
+        if (dir != nullptr) {
+            reportDir_ = dir;
+        }
+    }
+
+    ~TilingReport()
+    {
+        Write();
+    }
+
+    void WriteLatencyReport()
+    {
+        const std::string path = reportDir_ + "/tiling_latency.json";
+        std::FILE *file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return;
+        }
+        std::fprintf(file, "[\n");
+        for (size_t i = 0; i < samples_.size(); ++i) {
+            const TilingSample &sample = samples_[i];
+            std::fprintf(file, "  {\"case\": \"%s\", \"op\": \"%s\", \"test\": \"%s\", \"tilingKey\": %s, \"ns\": %lld, %s}%s\n",
+                         JsonEscape(sample.caseName).c_str(), JsonEscape(sample.op).c_str(),
+                         JsonEscape(sample.testName).c_str(), TilingKeyJson(sample).c_str(),
+                         static_cast<long long>(sample.durationNs), AllocStatsJson(sample).c_str(),
+                         i + 1 == samples_.size() ? "" : ",");
+        }
+        std::fprintf(file, "]\n");
+        std::fclose(file);
+    }
+
+    void WriteTrace()
+    {
+        const std::string path = reportDir_ + "/tiling_trace.json";
+        std::FILE *file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return;
+        }
+        const int64_t origin = samples_.empty() ? 0 : samples_.front().startNs;
+        const int pid = static_cast<int>(getpid());
+        std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+        for (size_t i = 0; i < samples_.size(); ++i) {
+            const TilingSample &sample = samples_[i];
+            // Chrome trace 以微秒为单位，保留小数以体现纳秒精度
+            std::fprintf(file,
+                         "  {\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+                         "\"pid\": %d, \"tid\": %u, \"args\": {\"tilingKey\": %s, %s}}%s\n",
+                         JsonEscape(sample.caseName).c_str(), JsonEscape(sample.op).c_str(),
+                         (sample.startNs - origin) / 1000.0, sample.durationNs / 1000.0, pid, sample.tid,
+                         TilingKeyJson(sample).c_str(), AllocStatsJson(sample).c_str(),
+                         i + 1 == samples_.size() ? "" : ",");
+        }
+        std::fprintf(file, "]}\n");
+        std::fclose(file);
+    }
+
+    void WriteResults()
+    {
+        if (results_.empty()) {
+            return;
+        }
+        const std::string path = reportDir_ + "/tiling_results.json";
+        std::FILE *file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            return;
+        }
+        std::fprintf(file, "[\n");
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const TilingResult &result = results_[i];
+            std::string workspaces;
+            for (size_t j = 0; j < result.workspaces.size(); ++j) {
+                workspaces += (j == 0 ? "" : ", ") + std::to_string(result.workspaces[j]);
+            }
+            std::fprintf(file,
+                         "  {\"case\": \"%s\", \"op\": \"%s\", \"success\": %s, \"tilingKey\": %lld, "
+                         "\"blockDim\": %lld, \"workspaces\": [%s], \"tilingDataSize\": %zu, \"tilingDataCapacity\": %llu}%s\n",
+                         JsonEscape(result.caseName).c_str(), JsonEscape(result.op).c_str(),
+                         result.success ? "true" : "false", static_cast<long long>(result.tilingKey),
+                         static_cast<long long>(result.blockDim), workspaces.c_str(), result.tilingDataSize,
+                         static_cast<unsigned long long>(result.tilingDataCapacity),
+                         i + 1 == results_.size() ? "" : ",");
+        }
+        std::fprintf(file, "]\n");
+        std::fclose(file);
+    }
+
+    std::string reportDir_;
+    bool dirty_{false};
+    std::mutex mutex_;
+    std::vector<TilingSample> samples_;
+    std::vector<TilingResult> results_;
+};
+
+// 测试程序结束时写出报告；用例库 (runner 加载) 场景下由 TilingReport 析构兜底
+class TilingReportListener : public ::testing::EmptyTestEventListener {
+public:
+    void OnTestProgramEnd(const ::testing::UnitTest &) override
+    {
+        TilingReport::Instance().Write();
+    }
+};
+
+inline bool RegisterTilingReportListener()
+{
+    if (TilingReport::Instance().Enabled()) {
+        ::testing::UnitTest::GetInstance()->listeners().Append(new TilingReportListener);
+    }
+    return true;
+}
+
+inline const bool g_tilingReportListenerRegistered = RegisterTilingReportListener();
+
+class TilingProbe {
+public:
+    TilingProbe(const char *op, const std::string &caseName) : enabled_(TilingReport::Instance().Enabled())
+    {
+        // 用例名同时供 CaptureTilingResult 使用，不论是否记录耗时
+        sample_.op = op;
+        sample_.caseName = caseName;
+        if (!enabled_) {
+            return;
+        }
+        const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        if (info != nullptr) {
+            sample_.testName = std::string(info->test_suite_name()) + "." + info->name();
+        }
+        sample_.tid = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFFFFFFu);
+        if (AllocHookAvailable()) {
+            UTGenAllocScopeBegin();
+        }
+        sample_.startNs = MonotonicNs();
+    }
+
+    ~TilingProbe()
+    {
+        Stop();
+    }
+
+    TilingProbe(const char *op, const std::string &caseName, uint64_t tilingKey) : TilingProbe(op, caseName)
+    {
+        SetTilingKey(tilingKey);
+    }
+
+    // 期望 tiling key 只在部分分支中已知时，由分支内补充
+    void SetTilingKey(uint64_t tilingKey)
+    {
+        sample_.hasTilingKey = true;
+        sample_.tilingKey = tilingKey;
+    }
+
+    // 提前结束计时，之后的代码 (如结果采集、耗时预算检查) 不计入本次样本
+    void Stop()
+    {
+        if (!enabled_) {
+            return;
+        }
+        enabled_ = false;
+        sample_.durationNs = MonotonicNs() - sample_.startNs;
+        if (AllocHookAvailable()) {
+            UTGenAllocScopeEnd(&sample_.allocStats);
+            sample_.hasAllocStats = true;
+        }
+        TilingReport::Instance().Add(sample_);
+    }
+
+    const std::string &Op() const
+    {
+        return sample_.op;
+    }
+
+    const std::string &CaseName() const
+    {
+        return sample_.caseName;
+    }
+
+    TilingProbe(const TilingProbe &) = delete;
+    TilingProbe &operator=(const TilingProbe &) = delete;
+
+private:
+    bool enabled_;
+    TilingSample sample_;
+};
+
+} // namespace UTGen
+
+#endif // UTGEN_TILING_PROBE_H
@@ -0,0 +1,457 @@
+/**
+ * This program is free software, you can redistribute it and/or modify.
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This file is a part of the CANN Open Software.
+ * Licensed under CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+/*
+ * tiling 结果快照存储 (header-only)
+ *
+ * 用例只断言 tiling key，tile 大小等变化不会改变 key 却会影响 kernel 性能。
+ * CaptureTilingResult (见 utgen_tiling_capture.h) 在两种模式下使用本存储:
+ *   UTGEN_TILING_RECORD=<file>  记录每个用例完整的 tiling data、block dim 与 workspace，测试程序结束时写出
+ *   UTGEN_TILING_VERIFY=<file>  mmap 已记录的存储，逐字节比较本次 tiling 的结果，不一致时用例失败；
+ *                               存储中没有的用例只告警
+ *
+ * 文件格式 (小端，各段 8 字节对齐)，tiling data 按内容去重 (FNV-1a 64 定位，逐字节确认；
+ * 不同内容 hash 冲突时顺延到下一个未占用的 hash 值):
+ *   StoreHeader
+ *   StoreEntry[entryCount]   按用例名 hash 排序，用例名为 "<op>/<case>"
+ *   StoreBlob[blobCount]     按内容 hash 排序
+ *   int64_t workspaces[workspaceCount]
+ *   char names[nameBytes]
+ *   tiling data
+ * utils/tiling_store.py 可列出、查看与比较两个存储。
+ */
+#ifndef UTGEN_TILING_STORE_H
+#define UTGEN_TILING_STORE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utgen_log.h"
+#include "utgen_tiling_exec.h"
+
+namespace UTGen {
+
+constexpr char kTilingStoreMagic[4] = {'U', 'T', 'G', 'S'};
+constexpr uint32_t kTilingStoreVersion = 1;
+
+struct StoreHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t blobCount;
+    uint64_t workspaceCount;
+    uint64_t nameBytes;
+};
+
+struct StoreEntry {
+    uint64_t nameHash;
+    uint32_t nameOffset;
+    uint32_t nameLen;
+    uint64_t blobHash;
+    int64_t tilingKey;
+    int64_t blockDim;
+    uint32_t workspaceOffset;
+    uint32_t workspaceCount;
+};
+
+struct StoreBlob {
+    uint64_t hash;
+    // 相对文件起始的偏移
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(StoreHeader) == 32, "StoreHeader layout");
+static_assert(sizeof(StoreEntry) == 48, "StoreEntry layout");
+static_assert(sizeof(StoreBlob) == 24, "StoreBlob layout");
+
+inline uint64_t Fnv1a64(const void *data, size_t size)
+{
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+inline size_t AlignUp8(size_t size)
+{
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+// [offset, offset + size) 是否落在 [0, limit) 内，避免 offset + size 溢出回绕
+inline bool RangeWithin(uint64_t offset, uint64_t size, uint64_t limit)
+{
+    return offset <= limit && size <= limit - offset;
+}
+
+class TilingStore {
+public:
+    static TilingStore &Instance()
+    {
+        static TilingStore instance;
+        return instance;
+    }
+
+    bool Recording() const
+    {
+        return !recordPath_.empty();
+    }
+
+    bool Verifying() const
+    {
+        return !verifyPath_.empty();
+    }
+
+    bool Active() const
+    {
+        return Recording() || Verifying();
+    }
+
+    void Record(const std::string &caseId, const TilingInfo &tilingInfo)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint8_t *data = tilingInfo.tilingData.get();
+        std::vector<uint8_t> bytes(data, data + (data == nullptr ? 0 : tilingInfo.tilingDataSize));
+        uint64_t blobHash = Fnv1a64(bytes.data(), bytes.size());
+        // hash 只用于定位，字节相同才复用已有 blob
+        for (auto blob = blobs_.find(blobHash); blob != blobs_.end() && blob->second != bytes;
+             blob = blobs_.find(++blobHash)) {
+        }
+        auto it = entries_.find(caseId);
+        if (it != entries_.end() && it->second.blobHash != blobHash) {
+            UTGEN_LOG(WARN).With("case", caseId) << "duplicate case name with different tiling data, keep the last one";
+        }
+        blobs_.emplace(blobHash, std::move(bytes));
+        RecordedEntry &entry = entries_[caseId];
+        entry.blobHash = blobHash;
+        entry.tilingKey = static_cast<int64_t>(tilingInfo.tilingKey);
+        entry.blockDim = static_cast<int64_t>(tilingInfo.blockNum);
+        entry.workspaces.assign(tilingInfo.workspaceSizes.begin(), tilingInfo.workspaceSizes.end());
+        dirty_ = true;
+    }
+
+    // 与存储中的记录逐字节比较，返回差异描述；一致或存储中没有该用例时返回空串
+    std::string Verify(const std::string &caseId, bool success, const TilingInfo &tilingInfo)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!MapVerifyFile()) {
+            return "cannot open or validate tiling store " + verifyPath_;
+        }
+        const StoreEntry *entry = Find(caseId);
+        if (entry == nullptr) {
+            UTGEN_LOG(WARN).With("case", caseId) << "case not found in tiling store";
+            return "";
+        }
+        if (!success) {
+            return "tiling failed, recorded tilingKey " + std::to_string(entry->tilingKey);
+        }
+        std::string diff;
+        if (entry->tilingKey != static_cast<int64_t>(tilingInfo.tilingKey)) {
+            diff += "tilingKey " + std::to_string(entry->tilingKey) + " -> " + std::to_string(tilingInfo.tilingKey) + "; ";
+        }
+        if (entry->blockDim != static_cast<int64_t>(tilingInfo.blockNum)) {
+            diff += "blockDim " + std::to_string(entry->blockDim) + " -> " + std::to_string(tilingInfo.blockNum) + "; ";
+        }
+        const int64_t *workspaces = Workspaces() + entry->workspaceOffset;
+        const bool workspacesEqual =
+            entry->workspaceCount == tilingInfo.workspaceSizes.size() &&
+            std::equal(tilingInfo.workspaceSizes.begin(), tilingInfo.workspaceSizes.end(), workspaces,
+                       [](const auto &actual, int64_t expected) { return static_cast<int64_t>(actual) == expected; });
+        if (!workspacesEqual) {
+            diff += "workspaces changed; ";
+        }
+        const StoreBlob *blob = FindBlob(entry->blobHash);
+        if (blob == nullptr) {
+            return diff + "tiling data blob missing in store";
+        }
+        const uint8_t *expected = base_ + blob->offset;
+        const uint8_t *actual = tilingInfo.tilingData.get();
+        const size_t actualSize = actual == nullptr ? 0 : tilingInfo.tilingDataSize;
+        const size_t common = std::min<size_t>(blob->size, actualSize);
+        const auto mismatch = std::mismatch(expected, expected + common, actual);
+        if (mismatch.first != expected + common) {
+            diff += "tiling data differs at byte " + std::to_string(mismatch.first - expected) + "; ";
+        }
+        if (blob->size != actualSize) {
+            diff += "tiling data size " + std::to_string(blob->size) + " -> " + std::to_string(actualSize) + "; ";
+        }
+        return diff;
+    }
+
+    void Write()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!Recording() || !dirty_) {
+            return;
+        }
+        WriteStore();
+        dirty_ = false;
+    }
+
+    TilingStore(const TilingStore &) = delete;
+    TilingStore &operator=(const TilingStore &) = delete;
+
+private:
+    struct RecordedEntry {
+        uint64_t blobHash{0};
+        int64_t tilingKey{-1};
+        int64_t blockDim{-1};
+        std::vector<int64_t> workspaces;
+    };
+
+    TilingStore()
+    {
+        const char *record = std::getenv("UTGEN_TILING_RECORD");
+        const char *verify = std::getenv("UTGEN_TILING_VERIFY");
+        if (record != nullptr) {
+            recordPath_ = record;
+        }
+        if (verify != nullptr) {
+            verifyPath_ = verify;
+        }
+    }
+
+    ~TilingStore()
+    {
+        Write();
+        if (base_ != nullptr) {
+            munmap(const_cast<uint8_t *>(base_), mappedSize_);
+        }
+    }
+
+    bool MapVerifyFile()
+    {
+        if (base_ != nullptr) {
+            return true;
+        }
+        if (mapFailed_) {
+            return false;
+        }
+        mapFailed_ = true;
+        const int fd = open(verifyPath_.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st {};
+        void *mapped = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(StoreHeader)) {
+            mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        base_ = static_cast<const uint8_t *>(mapped);
+        mappedSize_ = st.st_size;
+        if (!ValidateStore()) {
+            UTGEN_LOG(ERROR).With("path", verifyPath_) << "tiling store is corrupt or has an unsupported version";
+            munmap(mapped, mappedSize_);
+            base_ = nullptr;
+            mappedSize_ = 0;
+            return false;
+        }
+        mapFailed_ = false;
+        return true;
+    }
+
+    // 映射后一次性检查所有表与各条记录引用的范围，之后的查找与比较不再越界
+    bool ValidateStore() const
+    {
+        const StoreHeader &header = Header();
+        if (std::memcmp(header.magic, kTilingStoreMagic, sizeof(kTilingStoreMagic)) != 0 ||
+            header.version != kTilingStoreVersion) {
+            return false;
+        }
+        // entryCount/blobCount 为 32 位，乘积不会溢出；64 位的计数先与文件大小比较再参与求和
+        const uint64_t size = mappedSize_;
+        if (header.workspaceCount > size / sizeof(int64_t) || header.nameBytes > size) {
+            return false;
+        }
+        const uint64_t tablesEnd = sizeof(StoreHeader) + uint64_t{header.entryCount} * sizeof(StoreEntry) +
+                                   uint64_t{header.blobCount} * sizeof(StoreBlob) +
+                                   header.workspaceCount * sizeof(int64_t) + header.nameBytes;
+        if (tablesEnd > size) {
+            return false;
+        }
+        for (const StoreEntry *entry = Entries(); entry != Entries() + header.entryCount; ++entry) {
+            if (!RangeWithin(entry->nameOffset, entry->nameLen, header.nameBytes) ||
+                !RangeWithin(entry->workspaceOffset, entry->workspaceCount, header.workspaceCount)) {
+                return false;
+            }
+        }
+        for (const StoreBlob *blob = Blobs(); blob != Blobs() + header.blobCount; ++blob) {
+            if (blob->offset < tablesEnd || !RangeWithin(blob->offset, blob->size, size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const StoreHeader &Header() const
+    {
+        return *reinterpret_cast<const StoreHeader *>(base_);
+    }
+
+    const StoreEntry *Entries() const
+    {
+        return reinterpret_cast<const StoreEntry *>(base_ + sizeof(StoreHeader));
+    }
+
+    const StoreBlob *Blobs() const
+    {
+        return reinterpret_cast<const StoreBlob *>(Entries() + Header().entryCount);
+    }
+
+    const int64_t *Workspaces() const
+    {
+        return reinterpret_cast<const int64_t *>(Blobs() + Header().blobCount);
+    }
+
+    const char *Names() const
+    {
+        return reinterpret_cast<const char *>(Workspaces() + Header().workspaceCount);
+    }
+
+    const StoreEntry *Find(const std::string &caseId) const
+    {
+        const uint64_t hash = Fnv1a64(caseId.data(), caseId.size());
+        const StoreEntry *begin = Entries();
+        const StoreEntry *end = begin + Header().entryCount;
+        auto it = std::lower_bound(begin, end, hash,
+                                   [](const StoreEntry &entry, uint64_t value) { return entry.nameHash < value; });
+        // hash 冲突时逐个比较用例名
+        for (; it != end && it->nameHash == hash; ++it) {
+            if (caseId.compare(0, std::string::npos, Names() + it->nameOffset, it->nameLen) == 0) {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+
+    const StoreBlob *FindBlob(uint64_t hash) const
+    {
+        const StoreBlob *begin = Blobs();
+        const StoreBlob *end = begin + Header().blobCount;
+        auto it = std::lower_bound(begin, end, hash,
+                                   [](const StoreBlob &blob, uint64_t value) { return blob.hash < value; });
+        return it != end && it->hash == hash ? it : nullptr;
+    }
+
+    void WriteStore()
+    {
+        std::vector<StoreEntry> entries;
+        std::vector<int64_t> workspaces;
+        std::string names;
+        for (const auto &item : entries_) {
+            StoreEntry entry{};
+            entry.nameHash = Fnv1a64(item.first.data(), item.first.size());
+            entry.nameOffset = static_cast<uint32_t>(names.size());
+            entry.nameLen = static_cast<uint32_t>(item.first.size());
+            entry.blobHash = item.second.blobHash;
+            entry.tilingKey = item.second.tilingKey;
+            entry.blockDim = item.second.blockDim;
+            entry.workspaceOffset = static_cast<uint32_t>(workspaces.size());
+            entry.workspaceCount = static_cast<uint32_t>(item.second.workspaces.size());
+            names += item.first;
+            workspaces.insert(workspaces.end(), item.second.workspaces.begin(), item.second.workspaces.end());
+            entries.push_back(entry);
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const StoreEntry &a, const StoreEntry &b) { return a.nameHash < b.nameHash; });
+        names.resize(AlignUp8(names.size()), '\0');
+
+        StoreHeader header{};
+        std::memcpy(header.magic, kTilingStoreMagic, sizeof(kTilingStoreMagic));
+        header.version = kTilingStoreVersion;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.blobCount = static_cast<uint32_t>(blobs_.size());
+        header.workspaceCount = workspaces.size();
+        header.nameBytes = names.size();
+
+        // blobs_ 按 hash 有序，偏移依次累加
+        std::vector<StoreBlob> blobs;
+        uint64_t offset = sizeof(StoreHeader) + entries.size() * sizeof(StoreEntry) +
+                          blobs_.size() * sizeof(StoreBlob) + workspaces.size() * sizeof(int64_t) + names.size();
+        for (const auto &item : blobs_) {
+            blobs.push_back(StoreBlob{item.first, offset, item.second.size()});
+            offset += AlignUp8(item.second.size());
+        }
+
+        const std::string tmpPath = recordPath_ + ".tmp";
+        std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+        if (file == nullptr) {
+            UTGEN_LOG(ERROR).With("path", tmpPath) << "cannot write tiling store";
+            return;
+        }
+        static const char padding[8] = {};
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fwrite(entries.data(), sizeof(StoreEntry), entries.size(), file);
+        std::fwrite(blobs.data(), sizeof(StoreBlob), blobs.size(), file);
+        std::fwrite(workspaces.data(), sizeof(int64_t), workspaces.size(), file);
+        std::fwrite(names.data(), 1, names.size(), file);
+        for (const auto &item : blobs_) {
+            std::fwrite(item.second.data(), 1, item.second.size(), file);
+            std::fwrite(padding, 1, AlignUp8(item.second.size()) - item.second.size(), file);
+        }
+        std::fclose(file);
+        std::rename(tmpPath.c_str(), recordPath_.c_str());
+    }
+
+    std::string recordPath_;
+    std::string verifyPath_;
+    bool dirty_{false};
+    std::mutex mutex_;
+    std::map<std::string, RecordedEntry> entries_;
+    std::map<uint64_t, std::vector<uint8_t>> blobs_;
+
+    const uint8_t *base_{nullptr};
+    size_t mappedSize_{0};
+    bool mapFailed_{false};
+};
+
+// 测试程序结束时写出存储；用例库 (runner 加载) 场景下由 TilingStore 析构兜底
+class TilingStoreListener : public ::testing::EmptyTestEventListener {
+public:
+    void OnTestProgramEnd(const ::testing::UnitTest &) override
+    {
+        TilingStore::Instance().Write();
+    }
+};
+
+inline bool RegisterTilingStoreListener()
+{
+    if (TilingStore::Instance().Recording()) {
+        ::testing::UnitTest::GetInstance()->listeners().Append(new TilingStoreListener);
+    }
+    return true;
+}
+
+inline const bool g_tilingStoreListenerRegistered = RegisterTilingStoreListener();
+
+} // namespace UTGen
+
+#endif // UTGEN_TILING_STORE_H
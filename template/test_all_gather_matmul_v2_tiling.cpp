@@ -8,10 +8,13 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "../../../../../tests/ut/framework_normal/common/mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace AllGatherMatmulV2UT {
 
@@ -61,18 +64,20 @@ struct AllGatherMatmulTilingTestParam {
 
     bool expectSuccess;
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class AllGatherMatmulV2TilingParam : public ::testing::TestWithParam<AllGatherMatmulTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "AllGatherMatmulV2Tiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "AllGatherMatmulV2Tiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "AllGatherMatmulV2Tiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "AllGatherMatmulV2Tiling TearDown";
     }
 };
 
@@ -128,12 +133,16 @@ void TestOneParamCase(const AllGatherMatmulTilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize, param.tilingDataSize, param.compile_info);
 
+    UTGen::TilingProbe probe("AllGatherMatmulV2", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (!param.expectSuccess) {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_FAILED, 0);
     } else {
+        probe.SetTilingKey(param.expectTilingKey);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(AllGatherMatmulV2TilingParam, general_case)
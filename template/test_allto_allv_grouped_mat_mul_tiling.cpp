@@ -10,10 +10,13 @@
 
 #include "../../../op_host/op_tiling/allto_allv_grouped_mat_mul_tiling.h"
 
-#include <iostream>
 #include <gtest/gtest.h>
 
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 using namespace std;
 
@@ -26,14 +29,6 @@ auto build_from(const T &value)
 {
     return Ops::Transformer::AnyValue::CreateFrom<T>(value);
 }
-struct TestParam {
-    string test_name{};
-    std::vector<std::pair<string, string>> tiling_params_str_pair{};
-    std::vector<std::pair<string, std::vector<int64_t>>> tiling_params_vec_pair{};
-    std::vector<std::pair<size_t, ge::DataType>> tiling_dTypes_pair{};
-    ge::graphStatus status;
-};
-
 struct TilingParams {
     uint64_t BSK{4096};
     uint64_t BS{2048};
@@ -63,74 +58,16 @@ struct TilingParams {
                                      128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128};
 };
 
-std::unordered_map<string, std::function<void(TilingParams& tiling_params, const string& value_str)>>
-    tiling_params_str_handlers = {
-        {"BSK", [](TilingParams& tiling_params, const string& value_str) { tiling_params.BSK = std::stoi(value_str); }},
-        {"BS", [](TilingParams& tiling_params, const string& value_str) { tiling_params.BS = std::stoi(value_str); }},
-        {"K", [](TilingParams& tiling_params, const string& value_str) { tiling_params.K = std::stoi(value_str); }},
-        {"H1", [](TilingParams& tiling_params, const string& value_str) { tiling_params.H1 = std::stoi(value_str); }},
-        {"H2", [](TilingParams& tiling_params, const string& value_str) { tiling_params.H2 = std::stoi(value_str); }},
-        {"A", [](TilingParams& tiling_params, const string& value_str) { tiling_params.A = std::stoi(value_str); }},
-        {"N1", [](TilingParams& tiling_params, const string& value_str) { tiling_params.N1 = std::stoi(value_str); }},
-        {"N2", [](TilingParams& tiling_params, const string& value_str) { tiling_params.N2 = std::stoi(value_str); }},
-        {"ep_world_size", [](TilingParams& tiling_params,
-                             const string& value_str) { tiling_params.ep_world_size = std::stoi(value_str); }},
-        {"e", [](TilingParams& tiling_params, const string& value_str) { tiling_params.e = std::stoi(value_str); }},
-        {"gmm_weight_dim1", [](TilingParams& tiling_params,
-                               const string& value_str) { tiling_params.gmm_weight_dim1 = std::stoi(value_str); }},
-        {"gmm_y_dim1",
-         [](TilingParams& tiling_params, const string& value_str) { tiling_params.gmm_y_dim1 = std::stoi(value_str); }},
-        {"mm_weight_dim0", [](TilingParams& tiling_params,
-                              const string& value_str) { tiling_params.mm_weight_dim0 = std::stoi(value_str); }},
-        {"trans_gmm_weight", [](TilingParams& tiling_params,
-                                const string& value_str) { tiling_params.trans_gmm_weight = value_str == "true"; }},
-        {"trans_mm_weight", [](TilingParams& tiling_params,
-                               const string& value_str) { tiling_params.trans_mm_weight = value_str == "true"; }},
-        {"permute_out_flag", [](TilingParams& tiling_params, const string& value_str) {
-             tiling_params.permute_out_flag = value_str == "true";
-         }},
-        {"is_Need_MM", [](TilingParams& tiling_params, const string& value_str) {
-             tiling_params.is_Need_MM = value_str == "true";
-         }}
-        };
-
-std::unordered_map<string, std::function<void(TilingParams& tiling_params, const std::vector<int64_t> value_vec)>>
-    tiling_params_vec_handlers = {
-        {"send_counts", [](TilingParams& tiling_params,
-                           const std::vector<int64_t> value_vec) { tiling_params.send_counts = value_vec; }},
-        {"recv_counts", [](TilingParams& tiling_params, const std::vector<int64_t> value_vec) {
-             tiling_params.recv_counts = value_vec;
-         }}};
-
-bool has_any_target_key(
-    const std::vector<std::pair<std::string, std::string>>& params,
-    const std::vector<std::string>& targets
-) {
-    return std::any_of(
-        params.begin(),
-        params.end(),
-        [&targets](const auto& p) {
-            return std::find(targets.begin(), targets.end(), p.first) != targets.end();
-        }
-    );
-}
-
-void InitializeTilingParams(
-    const TestParam& test_param,
-    TilingParams& tiling_params
-) {
-    for (auto& kv : test_param.tiling_params_str_pair) {
-        if (tiling_params_str_handlers.count(kv.first) != 0) {
-            tiling_params_str_handlers[kv.first](tiling_params, kv.second);
-        }
-    }
-
-    for (auto& kv : test_param.tiling_params_vec_pair) {
-        if (tiling_params_vec_handlers.count(kv.first) != 0) {
-            tiling_params_vec_handlers[kv.first](tiling_params, kv.second);
-        }
-    }
-}
+// 用例参数由生成器在生成阶段完成解析与溢出校验，直接物化为 TilingParams 初始化列表
+struct TestParam {
+    string test_name{};
+    TilingParams tiling_params{};
+    // 用例是否显式指定了 BS / H2 / mm_weight_dim0 / N2 中的任意一个
+    bool has_mm_keys{false};
+    ge::graphStatus status;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
+};
 
 std::unique_ptr<gert::TilingContextPara::TensorDescription> CreateTensorShape(
     gert::StorageShape shape,
@@ -196,19 +133,13 @@ class AlltoAllvGroupedMatMulTiling : public testing::TestWithParam<TestParam>
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "AlltoAllvGroupedMatMulTiling Test SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "AlltoAllvGroupedMatMulTiling Test SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "AlltoAllvGroupedMatMulTiling Test TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "AlltoAllvGroupedMatMulTiling Test TearDown";
     }
-
-public:
-    std::vector<int64_t> send_counts{128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-                                     128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128};
-    std::vector<int64_t> recv_counts{128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-                                     128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128};
 };
 
 void TestOneParamCase(const TestParam &test_param)
@@ -221,10 +152,7 @@ void TestOneParamCase(const TestParam &test_param)
     uint64_t ubSize = 196608;
     uint64_t tilingDataSize = 8192;
 
-    TilingParams tiling_params;
-    InitializeTilingParams(test_param, tiling_params);
-
-    std::vector<std::string> targets = {"BS", "H2", "mm_weight_dim0", "N2"};
+    const TilingParams &tiling_params = test_param.tiling_params;
 
     auto mm_x_shape = CreateTensorShape({{tiling_params.BS, tiling_params.H2}, {tiling_params.BS, tiling_params.H2}},
                                         ge::DT_FLOAT16, ge::FORMAT_ND);
@@ -234,7 +162,7 @@ void TestOneParamCase(const TestParam &test_param)
     auto mm_y_shape = CreateTensorShape({{tiling_params.BS, tiling_params.N2}, {tiling_params.BS, tiling_params.N2}},
                                         ge::DT_FLOAT16, ge::FORMAT_ND);
 
-    if (!(has_any_target_key(test_param.tiling_params_str_pair, targets) || tiling_params.is_Need_MM == false)) {
+    if (!(test_param.has_mm_keys || tiling_params.is_Need_MM == false)) {
         mm_x_shape->shape_ = {};
         mm_weight_shape->shape_ = {};
         mm_y_shape->shape_ = {};
@@ -255,6 +183,7 @@ void TestOneParamCase(const TestParam &test_param)
         },
         &compileInfo, socVersion, coreNum, ubSize, tilingDataSize);
 
+    UTGen::TilingProbe probe("AlltoAllvGroupedMatMul", test_param.test_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (test_param.status == ge::GRAPH_FAILED) {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
@@ -263,8 +192,11 @@ void TestOneParamCase(const TestParam &test_param)
         if (test_param.test_name == "Test_no_MM") {
             expectTilingKey = 256UL;
         }
+        probe.SetTilingKey(expectTilingKey);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, expectTilingKey);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, test_param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(AlltoAllvGroupedMatMulTiling, general_case)
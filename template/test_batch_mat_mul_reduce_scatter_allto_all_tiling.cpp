@@ -8,7 +8,6 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <map>
 #include <vector>
 #include <string>
@@ -19,6 +18,10 @@
 #include <opdev/platform.h>
 #include <gmock/gmock.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace BatchMatMulReduceScatterAlltoAllUT {
 
@@ -33,6 +36,7 @@ auto build_from(const T &value)
 struct BatchMatMulReduceScatterAlltoAllTilingTestParam {
     uint64_t inputTotalNum;
     std::string case_name;
+    std::string soc_version;
     uint64_t coreNum;
     uint64_t ubSize;
 
@@ -56,6 +60,8 @@ struct BatchMatMulReduceScatterAlltoAllTilingTestParam {
 
     bool hasExpectTilingKey;
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class BatchMatMulReduceScatterAlltoAllTilingParam
@@ -63,12 +69,12 @@ class BatchMatMulReduceScatterAlltoAllTilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "BatchMatMulReduceScatterAlltoAllTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "BatchMatMulReduceScatterAlltoAllTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "BatchMatMulReduceScatterAlltoAllTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "BatchMatMulReduceScatterAlltoAllTiling TearDown";
     }
 };
 
@@ -112,14 +118,18 @@ void TestOneParamCase(const BatchMatMulReduceScatterAlltoAllTilingTestParam &par
             {"y_shard_type", build_from<int64_t>(param.y_shard_type)},
             {"transpose_weight", build_from<bool>(param.transpose_weight)},
         },
-        &compileInfo, "Ascend910_93", param.coreNum, param.ubSize);
+        &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("BatchMatMulReduceScatterAlltoAll", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.hasExpectTilingKey) {
+        probe.SetTilingKey(param.expectTilingKey);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(BatchMatMulReduceScatterAlltoAllTilingParam, general_case)
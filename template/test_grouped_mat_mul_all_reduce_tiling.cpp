@@ -13,11 +13,14 @@
  * \brief
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace GroupedMatMulAllReduceUT {
 
@@ -46,6 +49,8 @@ struct GroupedMatMulAllReduceTilingTestParam {
 
     int64_t rankNum;
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class GroupedMatMulAllReduceTilingParam
@@ -53,12 +58,12 @@ class GroupedMatMulAllReduceTilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "GroupedMatMulAllReduceTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "GroupedMatMulAllReduceTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "GroupedMatMulAllReduceTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "GroupedMatMulAllReduceTiling TearDown";
     }
 };
 
@@ -109,8 +114,11 @@ void TestOneParamCase(const GroupedMatMulAllReduceTilingTestParam &param)
         param.ubSize,
         param.tilingDataSize);
 
+    UTGen::TilingProbe probe("GroupedMatMulAllReduce", param.case_name, param.expectTilingKey);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", param.rankNum}};
     Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(GroupedMatMulAllReduceTilingParam, general_case)
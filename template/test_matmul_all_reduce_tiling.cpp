@@ -8,10 +8,13 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MatmulAllReduceUT {
 template <typename T>
@@ -56,18 +59,20 @@ struct MatmulAllReduceTilingTestParam {
     bool is_trans_b;
 
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class MatmulAllReduceTilingParam : public ::testing::TestWithParam<MatmulAllReduceTilingTestParam> {
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MatmulAllReduceTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MatmulAllReduceTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulAllReduceTiling TearDown";
     }
 };
 
@@ -117,7 +122,10 @@ void TestOneParamCase(const MatmulAllReduceTilingTestParam& param){
         },
         &compileInfo, param.soc_version, param.compile_info, param.tilingDataSize);
 
+    UTGen::TilingProbe probe("MatmulAllReduce", param.case_name, param.expectTilingKey);
     ExecuteTestCase(tilingContextPara, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara);
 }
 
 TEST_P(MatmulAllReduceTilingParam, general_case)
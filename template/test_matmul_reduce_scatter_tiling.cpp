@@ -8,10 +8,13 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MatmulReduceScatterUT {
 
@@ -47,6 +50,8 @@ struct MatmulReduceScatterTilingTestParam {
     bool is_trans_b;
 
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class MatmulReduceScatterTilingParam
@@ -54,12 +59,12 @@ class MatmulReduceScatterTilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MatmulReduceScatterTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulReduceScatterTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MatmulReduceScatterTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MatmulReduceScatterTiling TearDown";
     }
 };
 
@@ -104,8 +109,11 @@ void TestOneParamCase(const MatmulReduceScatterTilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("MatmulReduceScatter", param.case_name, param.expectTilingKey);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expectTilingKey);
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(MatmulReduceScatterTilingParam, general_case)
@@ -8,11 +8,14 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <thread>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MoeDistributeCombineV2UT {
 
@@ -37,6 +40,8 @@ struct MoeDistributeCombineV2TilingTestParam {
 
     bool hasExpectTilingKey;
     uint64_t expectTilingKey;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 class MoeDistributeCombineV2TilingParam
@@ -44,12 +49,12 @@ class MoeDistributeCombineV2TilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MoeDistributeCombineV2Tiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeCombineV2Tiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MoeDistributeCombineV2Tiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeCombineV2Tiling TearDown";
     }
 };
 
@@ -67,14 +72,18 @@ void TestOneParamCase(const MoeDistributeCombineV2TilingTestParam &param)
         param.coreNum,
         param.ubSize);
 
+    UTGen::TilingProbe probe("MoeDistributeCombineV2", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
 
     if (param.hasExpectTilingKey) {
+        probe.SetTilingKey(param.expectTilingKey);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues,
             ge::GRAPH_SUCCESS, param.expectTilingKey);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(MoeDistributeCombineV2TilingParam, general_case)
@@ -7,11 +7,14 @@
  * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
  * See LICENSE in the root of the software repository for the full text of the License.
  */
-#include <iostream>
 #include <thread>
 #include <cctype>
 #include <gtest/gtest.h>
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MoeDistributeDispatchUT {
 
@@ -68,6 +71,8 @@ struct MoeDistributeDispatchTilingTestParam {
 
     bool has_expect_tiling_key;
     uint64_t expect_tiling_key;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 gert::StorageShape make_shape(const std::initializer_list<int64_t> &shape)
@@ -82,12 +87,12 @@ class MoeDistributeDispatchTilingParam : public ::testing::TestWithParam<MoeDist
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MoeDistributeDispatchTiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeDispatchTiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MoeDistributeDispatchTiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeDispatchTiling TearDown";
     }
 };
 
@@ -135,12 +140,16 @@ void TestOneParamCase(const MoeDistributeDispatchTilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("MoeDistributeDispatch", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.has_expect_tiling_key) {
+        probe.SetTilingKey(param.expect_tiling_key);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expect_tiling_key);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(MoeDistributeDispatchTilingParam, general_case)
@@ -8,7 +8,6 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 
-#include <iostream>
 #include <thread>
 #include <cctype>
 #include <map>
@@ -21,6 +20,10 @@
 #include "exe_graph/runtime/storage_shape.h"
 
 #include "mc2_tiling_case_executor.h"
+#include "utgen_log.h"
+#include "utgen_tiling_probe.h"
+#include "utgen_tiling_budget.h"
+#include "utgen_tiling_capture.h"
 
 namespace MoeDistributeDispatchV2 {
 
@@ -90,6 +93,8 @@ struct MoeDistributeDispatchV2TilingTestParam {
 
     bool has_expect_tiling_key;
     uint64_t expect_tiling_key;
+    // tiling 耗时/堆分配预算 (JSONL 中的 maxTilingLatencyUs / maxTilingAllocs / maxTilingAllocBytes)，未指定时不检查
+    UTGen::TilingBudget budget;
 };
 
 gert::StorageShape make_shape(const std::initializer_list<int64_t> &shape)
@@ -105,12 +110,12 @@ class MoeDistributeDispatchV2TilingParam
 protected:
     static void SetUpTestCase()
     {
-        std::cout << "MoeDistributeDispatchV2Tiling SetUp" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeDispatchV2Tiling SetUp";
     }
 
     static void TearDownTestCase()
     {
-        std::cout << "MoeDistributeDispatchV2Tiling TearDown" << std::endl;
+        UTGEN_LOG(INFO) << "MoeDistributeDispatchV2Tiling TearDown";
     }
 };
 
@@ -176,12 +181,16 @@ void TestOneParamCase(const MoeDistributeDispatchV2TilingTestParam &param)
         },
         &compileInfo, param.soc_version, param.coreNum, param.ubSize);
 
+    UTGen::TilingProbe probe("MoeDistributeDispatchV2", param.case_name);
     Mc2Hcom::MockValues hcomTopologyMockValues{{"rankNum", 8}};
     if (param.has_expect_tiling_key) {
+        probe.SetTilingKey(param.expect_tiling_key);
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues, ge::GRAPH_SUCCESS, param.expect_tiling_key);
     } else {
         Mc2ExecuteTestCase(tilingContextPara, hcomTopologyMockValues);
     }
+    UTGen::CaptureTilingResult(probe, tilingContextPara, hcomTopologyMockValues);
+    UTGen::ExpectTilingWithinBudget(probe, param.budget, tilingContextPara, hcomTopologyMockValues);
 }
 
 TEST_P(MoeDistributeDispatchV2TilingParam, general_case)
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+片上缓冲占用校验 (UB / L1 / L0)
+
+按用例的 tiling 决策 (见 case_model.py) 还原各级缓冲的分配，与 compile_info 中的容量
+(UB_SIZE、L1_SIZE、L0A/L0B/L0C_SIZE，没有 compile_info 时取 ubSize 与 SoC 默认值) 比较:
+  - L0A / L0B: baseM x baseK / baseK x baseN 切片 x dbL0A / dbL0B
+  - L0C:       baseM x baseN 的 fp32 累加 x dbL0C
+  - L1:        depthA1 个 A 块 (baseM x baseK) + depthB1 个 B 块 (baseK x baseN)
+  - UB:        向量核上双缓冲的数据块: 伪量化权重的 baseK x baseN 反量化块、MoE 的 token 行
+               (量化时另加 fp32 中间结果，combine 时另加 fp32 累加行)、AddRmsNorm 的整行
+报告两类问题:
+  - 溢出: 占用超过容量，tiling 在真实硬件上无法运行 (按整行估算的 UB 超出时只提示需要沿行切分)
+  - L1 利用不足: K 不小于 --large-k (默认 4096) 的 matmul 只用了不到 --low-l1 (默认 50%) 的 L1，
+                 可增大 depthA1 / depthB1 (stepKa / stepKb) 减少 K 方向的搬运次数
+名义 tile (没有快照存储或无法解码) 的结果只反映典型 tile，表中以 * 标出，不做 L1 利用率判断。
+
+用法:
+  python3 utils/buffer_footprint.py
+  python3 utils/buffer_footprint.py --op matmul_all_reduce --low-l1 0.4 --json footprint.json
+  python3 utils/buffer_footprint.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer --strict
+"""
+
+import argparse
+import json
+import sys
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional
+
+from case_model import CaseModel, add_model_args, fmt_bytes, models_from_args, short_id
+
+DEFAULT_LARGE_K = 4096
+DEFAULT_LOW_L1 = 0.5
+LEVELS = ("L0A", "L0B", "L0C", "L1", "UB")
+
+
+@dataclass
+class Footprint:
+    model: CaseModel
+    used: Dict[str, float] = field(default_factory=dict)
+    capacity: Dict[str, int] = field(default_factory=dict)
+    ub_note: str = ""
+    ub_split: bool = False      # UB 按整行驻留估算，超出时 kernel 需沿行切分而非无法运行
+
+    def ratio(self, level: str) -> Optional[float]:
+        if level not in self.used or not self.capacity.get(level):
+            return None
+        return self.used[level] / self.capacity[level]
+
+    @property
+    def overflow(self) -> List[str]:
+        return [lv for lv in LEVELS if (self.ratio(lv) or 0) > 1.0 and not (lv == "UB" and self.ub_split)]
+
+    @property
+    def needs_split(self) -> bool:
+        return self.ub_split and (self.ratio("UB") or 0) > 1.0
+
+    def low_l1(self, large_k: int, low: float) -> bool:
+        w, t = self.model.workload, self.model.tiling
+        # 名义 tile 的 depthA1/depthB1 是假设值，L1 利用率只对解码的 tiling 有意义
+        return w.has_cube and t.source == "decoded" and w.k >= large_k and (self.ratio("L1") or 1.0) < low
+
+    def l1_depth_hint(self) -> int:
+        """A/B 各保留相同块数时 L1 放得下的最大块数"""
+        t, w = self.model.tiling, self.model.workload
+        pair = t.base_k * (t.base_m * w.a_bytes + t.base_n * w.b_bytes)
+        return int(self.capacity["L1"] // pair) if pair else 0
+
+
+def ub_usage(model: CaseModel) -> Optional[tuple]:
+    """返回 (字节数, 说明, 是否按整行估算)；没有向量阶段的用例返回 None"""
+    w, t = model.workload, model.tiling
+    if w.has_cube and w.b_bytes < w.a_bytes:
+        # 伪量化: 向量核把 baseK x baseN 的低比特权重反量化为激活类型后写回 L1
+        return 2 * t.base_k * t.base_n * (w.b_bytes + w.a_bytes), "权重反量化块", False
+    if w.kind == "moe" and w.k:
+        hidden = w.k
+        quant = bool(w.comm) and w.comm[0].bytes < w.m * hidden * w.a_bytes
+        row = 2 * hidden * w.a_bytes
+        if quant:
+            row += hidden * 4 + 2 * (hidden + 32)
+        if "combine" in model.stem:
+            row += hidden * 4
+        return row, "token 行" + (" (量化)" if quant else ""), True
+    if w.vector_bytes and w.n and w.has_cube:
+        # AddRmsNorm: residual、allreduce 结果双缓冲输入，y / normOut 双缓冲输出，fp32 计算行
+        return w.n * (4 * w.c_bytes * 2 + 2 * 4), "AddRmsNorm 整行", True
+    return None
+
+
+def analyze(model: CaseModel) -> Footprint:
+    w, t, hw = model.workload, model.tiling, model.hw
+    fp = Footprint(model, capacity={"L0A": hw.l0a, "L0B": hw.l0b, "L0C": hw.l0c, "L1": hw.l1, "UB": hw.ub})
+    if w.has_cube:
+        fp.used["L0A"] = t.db_l0a * t.base_m * t.base_k * w.a_bytes
+        fp.used["L0B"] = t.db_l0b * t.base_k * t.base_n * w.b_bytes
+        fp.used["L0C"] = t.db_l0c * t.base_m * t.base_n * 4
+        fp.used["L1"] = t.base_k * (t.depth_a1 * t.base_m * w.a_bytes + t.depth_b1 * t.base_n * w.b_bytes)
+    ub = ub_usage(model)
+    if ub:
+        fp.used["UB"], fp.ub_note, fp.ub_split = ub
+    return fp
+
+
+def to_json(fp: Footprint, large_k: int, low: float) -> dict:
+    t = fp.model.tiling
+    data = {
+        "case": fp.model.case_id, "soc": fp.model.hw.soc, "tilingSource": t.source if t else None,
+        "levels": {lv: {"bytes": int(fp.used[lv]), "capacity": fp.capacity[lv], "ratio": round(fp.ratio(lv), 3)}
+                   for lv in LEVELS if lv in fp.used},
+        "overflow": fp.overflow, "ubNeedsSplit": fp.needs_split, "lowL1": fp.low_l1(large_k, low),
+    }
+    if fp.ub_note:
+        data["ubBuffer"] = fp.ub_note
+    if data["lowL1"]:
+        data["l1DepthHint"] = fp.l1_depth_hint()
+    return data
+
+
+def print_report(results: List[Footprint], large_k: int, low: float, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'tile':>14} " + " ".join(f"{lv:>6}" for lv in LEVELS))
+    shown = results[:top] if top else results
+    for fp in shown:
+        t, w = fp.model.tiling, fp.model.workload
+        tile = f"{t.base_m}x{t.base_n}x{t.base_k}" + ("" if t.source == "decoded" else "*") if w.has_cube else "-"
+        cells = " ".join(f"{fp.ratio(lv):>6.0%}" if fp.ratio(lv) is not None else f"{'-':>6}" for lv in LEVELS)
+        mark = "❌ " if fp.overflow else "⚠️ " if fp.low_l1(large_k, low) else "ℹ️ " if fp.needs_split else "   "
+        print(f"{mark}{short_id(fp.model.case_id, 61):<61} {tile:>14} {cells}")
+        for lv in fp.overflow:
+            what = f" ({fp.ub_note})" if lv == "UB" else ""
+            print(f"      {lv} 溢出{what}: {fmt_bytes(fp.used[lv])} > {fmt_bytes(fp.capacity[lv])}")
+        if fp.needs_split:
+            print(f"      {fp.ub_note} {fmt_bytes(fp.used['UB'])} 超出 UB {fmt_bytes(fp.capacity['UB'])}，需沿行切分")
+        if fp.low_l1(large_k, low):
+            print(f"      K={w.k} 时 L1 只用了 {fmt_bytes(fp.used['L1'])} / {fmt_bytes(fp.capacity['L1'])}，"
+                  f"depthA1/depthB1 {t.depth_a1}/{t.depth_b1} 可增大到 {fp.l1_depth_hint()}")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+    if any(fp.model.workload.has_cube and fp.model.tiling.source != "decoded" for fp in shown):
+        print("\n* 名义 tile: 没有快照存储或无法解码 tiling data 时按 L0 容量推导，depthA1/depthB1 取 2")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="片上缓冲占用校验 (UB / L1 / L0)")
+    add_model_args(parser)
+    parser.add_argument("--large-k", type=int, default=DEFAULT_LARGE_K,
+                        help=f"检查 L1 利用率的 K 下限 (默认 {DEFAULT_LARGE_K})")
+    parser.add_argument("--low-l1", type=float, default=DEFAULT_LOW_L1,
+                        help=f"L1 利用率低于该比例时标记 (默认 {DEFAULT_LOW_L1})")
+    parser.add_argument("--top", type=int, help="只列出前 N 个用例 (溢出在前，其次按 L1 利用率从低到高)")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在溢出的用例时返回非零")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    results = [fp for fp in (analyze(m) for m in models) if fp.used]
+    results.sort(key=lambda fp: (not fp.overflow, not fp.low_l1(args.large_k, args.low_l1), not fp.needs_split,
+                                 fp.ratio("L1") if fp.ratio("L1") is not None else 1.0))
+    print_report(results, args.large_k, args.low_l1, args.top)
+
+    overflow = [fp for fp in results if fp.overflow]
+    low = [fp for fp in results if fp.low_l1(args.large_k, args.low_l1)]
+    nominal = sum(1 for fp in results if fp.model.workload.has_cube and fp.model.tiling.source != "decoded")
+    print(f"\n{len(results)} 个用例, {len(overflow)} 个缓冲溢出, "
+          f"{len(low)} 个 K >= {args.large_k} 的 matmul L1 利用率低于 {args.low_l1:.0%}"
+          + (f" ({nominal} 个名义 tile 未判断)" if nominal else ""))
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(fp, args.large_k, args.low_l1) for fp in results], f, ensure_ascii=False, indent=2)
+    sys.exit(1 if args.strict and overflow else 0)
+
+
+if __name__ == "__main__":
+    main()
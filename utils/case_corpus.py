@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+input/*.jsonl 用例语料的公共读取函数，供 utils 下的分析工具共用
+
+  - read_jsonl:        即生成器 nodes/generate_unit_test.py 的宽松 JSONL 读取 (允许格式化的多行对象)
+  - load_corpus:       读取全部算子的用例，{"defaults": {...}} 记录中的硬件字段补到各用例上，与生成器一致
+  - probe_op_names:    JSONL 文件名 (如 matmul_all_reduce) -> 探针中的算子名 (如 MatmulAllReduce)，
+                       从 template/test_<op>_tiling.cpp 的 TilingProbe 构造中提取
+  - mock_rank_nums:    JSONL 文件名 -> 模板中 Mc2Hcom::MockValues 的 rankNum (通信域大小)，
+                       由用例字段给出 (param.rankNum) 时为 None
+  - template_attr_int: 模板中以常量构造的整型算子属性 (如 comm_turn)
+  - expected_tiling_key: 用例的期望 tiling key，没有期望 key 的用例返回 None
+"""
+
+import re
+import sys
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+ROOT = Path(__file__).resolve().parent.parent
+INPUT_DIR = ROOT / "input"
+TEMPLATE_DIR = ROOT / "template"
+
+# JSONL 的读取与默认值记录的约定以生成器为准
+if str(ROOT) not in sys.path:
+    sys.path.insert(0, str(ROOT))
+from nodes.generate_unit_test import apply_case_defaults, read_jsonl, split_case_defaults  # noqa: E402
+
+TILING_KEY_FIELDS = ("expectTilingKey", "expect_tiling_key", "tilingKey")
+HAS_TILING_KEY_FIELDS = ("hasExpectTilingKey", "has_expect_tiling_key")
+PROBE_RE = re.compile(r'TilingProbe\s+probe\(\s*"(\w+)"')
+MOCK_RANK_RE = re.compile(r'MockValues\s+\w+\s*\{\s*\{\s*"rankNum"\s*,\s*([\w.]+)\s*\}')
+
+
+def load_corpus(input_dir: Path = INPUT_DIR) -> Dict[str, List[Dict[str, Any]]]:
+    """JSONL 文件名 (不含扩展名) -> 用例列表"""
+    corpus = {}
+    for path in sorted(input_dir.glob("*.jsonl")):
+        cases, defaults = split_case_defaults(read_jsonl(path))
+        corpus[path.stem] = apply_case_defaults(cases, defaults)
+    return corpus
+
+
+def _template_texts(template_dir: Path) -> Dict[str, str]:
+    return {path.stem[len("test_"):-len("_tiling")]: path.read_text(encoding="utf-8")
+            for path in sorted(template_dir.glob("test_*_tiling.cpp"))}
+
+
+def probe_op_names(template_dir: Path = TEMPLATE_DIR) -> Dict[str, str]:
+    names = {}
+    for stem, text in _template_texts(template_dir).items():
+        match = PROBE_RE.search(text)
+        if match:
+            names[stem] = match.group(1)
+    return names
+
+
+def mock_rank_nums(template_dir: Path = TEMPLATE_DIR) -> Dict[str, Optional[int]]:
+    ranks: Dict[str, Optional[int]] = {}
+    for stem, text in _template_texts(template_dir).items():
+        match = MOCK_RANK_RE.search(text)
+        if match:
+            ranks[stem] = int(match.group(1)) if match.group(1).isdigit() else None
+    return ranks
+
+
+def template_attr_int(stem: str, names: List[str], template_dir: Path = TEMPLATE_DIR) -> Optional[int]:
+    """模板中 {"<name>", build_from<int64_t>(N)} 形式的常量属性，names 为候选属性名 (如 comm_turn / commTurn)"""
+    path = template_dir / f"test_{stem}_tiling.cpp"
+    if not path.exists():
+        return None
+    text = path.read_text(encoding="utf-8")
+    for name in names:
+        match = re.search(r'\{\s*"%s"\s*,\s*build_from<\w+>\(\s*(-?\d+)\s*\)' % re.escape(name), text)
+        if match:
+            return int(match.group(1))
+    return None
+
+
+def case_name(case: Dict[str, Any]) -> str:
+    return str(case.get("case_name") or case.get("caseName") or case.get("test_name") or "")
+
+
+def expected_tiling_key(case: Dict[str, Any]) -> Optional[int]:
+    flags = [case[flag] for flag in HAS_TILING_KEY_FIELDS if flag in case]
+    if flags and not flags[0]:
+        return None
+    for field in TILING_KEY_FIELDS:
+        if field in case:
+            key = int(case[field])
+            # 没有 has 标志的算子用 0 表示预期失败的用例
+            return key if key != 0 or flags else None
+    return None
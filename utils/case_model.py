@@ -0,0 +1,609 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+用例的性能建模输入，供 roofline / 通信重叠 / 调度模拟等离线分析工具共用
+
+  - Hardware: 片上容量取自用例 compile_info 中的 hardware_info (CORE_NUM、L0A/L0B/L0C_SIZE、L1_SIZE、
+              UB_SIZE、L2_SIZE)，没有 compile_info 的用例取 coreNum / ubSize 字段与硬件 profile 中的容量；
+              主频、算力与带宽为硬件 profile (registry/hardware_profiles.yaml) 登记的估计值，可用 --hw key=value 覆盖
+  - Workload: 从各算子 JSONL 字段归一化出的 matmul 规模 (batch/M/N/K)、数据类型字节数、
+              向量搬运量与通信阶段 (模式、每 rank 数据量、通信域大小)
+  - Tiling:   快照存储 (utils/tiling_store.py) 中的 tiling data 按 op_tiling 头文件解码
+              (utils/tiling_data_decoder.py) 后取出的 tile 决策；没有快照或无法解码时按片上容量推导名义 tile
+
+模型只用于在语料之间横向比较 tiling 决策，绝对时间不代表实测性能。
+"""
+
+import argparse
+import ast
+import json
+import os
+import re
+from dataclasses import dataclass, field, fields, replace
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple
+
+from case_corpus import case_name, load_corpus, mock_rank_nums, probe_op_names
+from hardware_profiles import profile_for_soc
+
+# 主频、算力、带宽等估计参数与没有 compile_info 时的片上容量按 socVersion 取自 registry/hardware_profiles.yaml，
+# 未登记的 SoC 按 DEFAULT_SOC 估计
+DEFAULT_SOC = "Ascend910B"
+
+# 相对 fp16 的 cube 算力倍数
+CUBE_RATE = {"fp16": 1.0, "fp32": 0.5, "int8": 2.0, "int4": 4.0}
+
+DTYPE_BYTES = {
+    "FLOAT16": 2, "FP16": 2, "BF16": 2, "FLOAT": 4, "FP32": 4, "DOUBLE": 8,
+    "INT8": 1, "UINT8": 1, "INT4": 0.5, "INT16": 2, "INT32": 4, "INT64": 8,
+    "HIFLOAT8": 1, "FLOAT8_E4M3FN": 1, "FLOAT8_E5M2": 1, "FLOAT4_E2M1": 0.5, "FLOAT4_E1M2": 0.5,
+}
+
+
+def dtype_name(dtype: Any) -> str:
+    """"ge::DT_FLOAT16" / "// 注释\\n ge::DT_BF16" / "BF16" -> "FLOAT16" / "BF16" / "BF16" """
+    text = str(dtype).strip().splitlines()[-1].strip() if str(dtype).strip() else ""
+    return text.replace("ge::", "").replace("DT_", "").upper()
+
+
+def dtype_bytes(dtype: Any, default: float = 2) -> float:
+    return DTYPE_BYTES.get(dtype_name(dtype), default)
+
+
+def cube_class(dtype: Any) -> str:
+    """cube 计算的精度档位，用于按 CUBE_RATE 缩放算力"""
+    name = dtype_name(dtype)
+    if name in ("INT4", "FLOAT4_E2M1", "FLOAT4_E1M2"):
+        return "int4"
+    if DTYPE_BYTES.get(name) == 1:
+        return "int8"
+    if name in ("FLOAT", "FP32"):
+        return "fp32"
+    return "fp16"
+
+
+def ceil_div(a: int, b: int) -> int:
+    return -(-a // b) if b else 0
+
+
+def prod(values) -> int:
+    result = 1
+    for v in values:
+        result *= int(v)
+    return result
+
+
+@dataclass
+class Hardware:
+    soc: str
+    aic_num: int
+    aiv_num: int
+    l0a: int
+    l0b: int
+    l0c: int
+    l1: int
+    ub: int
+    l2: int
+    freq_ghz: float
+    cube_flops_per_cycle: float
+    vector_bytes_per_cycle: float
+    hbm_gbps: float
+    l2_gbps: float
+    l1_gbps_per_core: float
+    link_gbps: float
+    link_latency_us: float
+
+    def cube_tflops(self, precision: str = "fp16", cores: Optional[int] = None) -> float:
+        cores = self.aic_num if cores is None else cores
+        return cores * self.freq_ghz * self.cube_flops_per_cycle * CUBE_RATE.get(precision, 1.0) / 1e3
+
+    def vector_gbps(self, cores: Optional[int] = None) -> float:
+        cores = self.aiv_num if cores is None else cores
+        return cores * self.freq_ghz * self.vector_bytes_per_cycle
+
+
+def parse_hw_overrides(items: List[str]) -> Dict[str, float]:
+    """--hw key=value 列表 -> {字段: 值}，字段名为 Hardware 的属性"""
+    names = {f.name for f in fields(Hardware)} - {"soc"}
+    overrides = {}
+    for item in items:
+        key, sep, value = item.partition("=")
+        if not sep or key not in names:
+            raise ValueError(f"--hw {item!r} 无效，可覆盖的字段: {', '.join(sorted(names))}")
+        overrides[key] = float(value)
+    return overrides
+
+
+def hardware_info(case: Dict[str, Any]) -> Dict[str, Any]:
+    text = case.get("compile_info")
+    if not text:
+        return {}
+    try:
+        info = json.loads(text) if isinstance(text, str) else text
+    except ValueError:
+        return {}
+    return info.get("hardware_info", {}) if isinstance(info, dict) else {}
+
+
+def hardware_for_case(case: Dict[str, Any], overrides: Optional[Dict[str, float]] = None) -> Hardware:
+    info = hardware_info(case)
+    soc = str(info.get("socVersion") or case.get("soc_version") or DEFAULT_SOC)
+    profile = profile_for_soc(soc) or profile_for_soc(DEFAULT_SOC)
+    perf = profile.perf
+
+    def size(name: str, case_field: Optional[str] = None) -> int:
+        if info.get(name):
+            return int(info[name])
+        if case_field and case.get(case_field):
+            return int(case[case_field])
+        return profile.hardware_info[name]
+
+    aic = size("CORE_NUM", "coreNum")
+    hw = Hardware(
+        soc=soc, aic_num=aic, aiv_num=int(aic * perf["aiv_per_aic"]),
+        l0a=size("L0A_SIZE"), l0b=size("L0B_SIZE"), l0c=size("L0C_SIZE"), l1=size("L1_SIZE"),
+        ub=size("UB_SIZE", "ubSize"), l2=size("L2_SIZE"),
+        **{k: v for k, v in perf.items() if k != "aiv_per_aic"})
+    if overrides:
+        hw = replace(hw, **{k: type(getattr(hw, k))(v) for k, v in overrides.items()})
+    return hw
+
+
+@dataclass
+class CommPhase:
+    pattern: str        # allreduce / allgather / reducescatter / alltoall / alltoallv / barrier
+    bytes: int          # 每个 rank 参与该阶段的逻辑数据量 (未乘通信算法系数)
+    world: int
+    raw_bytes: int = 0  # 通信量化时量化前的数据量，0 表示未量化
+
+
+@dataclass
+class Workload:
+    kind: str                       # matmul / grouped_matmul / moe / barrier / unknown
+    batch: int = 1
+    m: int = 0
+    n: int = 0
+    k: int = 0
+    a_bytes: float = 2
+    b_bytes: float = 2
+    c_bytes: float = 2
+    precision: str = "fp16"
+    vector_bytes: int = 0           # 向量核需要读写的数据量 (MoE 搬运、量化、RmsNorm 等)
+    comm: List[CommPhase] = field(default_factory=list)
+
+    @property
+    def flops(self) -> int:
+        return 2 * self.batch * self.m * self.n * self.k
+
+    @property
+    def has_cube(self) -> bool:
+        return self.kind in ("matmul", "grouped_matmul") and self.flops > 0
+
+    @property
+    def comm_bytes(self) -> int:
+        return sum(p.bytes for p in self.comm)
+
+    @property
+    def world_size(self) -> int:
+        return max((p.world for p in self.comm), default=1)
+
+
+def _mk(x1: List[int], x2: List[int]) -> Tuple[int, int, int]:
+    """x1 [.., M, K] 与 x2 的逻辑 M/N/K；JSONL 中转置用例的 x2 形状写法不统一，取与 K 不同的一维为 N"""
+    k = int(x1[-1]) if x1 else 0
+    m = prod(x1[:-1]) if len(x1) > 1 else 0
+    if len(x2) < 2:
+        return m, 0, k
+    n = int(x2[1]) if int(x2[0]) == k else int(x2[0])
+    return m, n, k
+
+
+def _mc2_matmul(case: Dict[str, Any], world: int, pattern: str, out_field: str) -> Workload:
+    m, n, k = _mk(case.get("x1_shape") or [], case.get("x2_shape") or [])
+    a, b = case.get("x1_dtype"), case.get("x2_dtype")
+    c = case.get(out_field, case.get("output_dtype", a))
+    w = Workload("matmul", m=m, n=n, k=k, a_bytes=dtype_bytes(a), b_bytes=dtype_bytes(b),
+                 c_bytes=dtype_bytes(c), precision=cube_class(a))
+    if pattern == "allgather":
+        # x1 为本 rank 的分片，gather 后参与计算的 M 为 world 倍
+        w.comm = [CommPhase("allgather", int(m * k * w.a_bytes), world)]
+        w.m = m * world
+    elif case.get("comm_quant_scale_1_shape"):
+        # 通信量化: 结果按 int8 参与通信，每列另带一个 fp16 scale
+        w.comm = [CommPhase(pattern, int(m * n + 2 * n), world, int(m * n * w.c_bytes))]
+    else:
+        w.comm = [CommPhase(pattern, int(m * n * w.c_bytes), world)]
+    return w
+
+
+def _all_gather_matmul(case, world):
+    return _mc2_matmul(case, world, "allgather", "output_dtype")
+
+
+def _matmul_all_reduce(case, world):
+    return _mc2_matmul(case, world, "allreduce", "output_dtype")
+
+
+def _matmul_reduce_scatter(case, world):
+    return _mc2_matmul(case, world, "reducescatter", "y_dtype")
+
+
+def _grouped_mat_mul_all_reduce(case, world):
+    return _mc2_matmul(case, int(case.get("rankNum") or world), "allreduce", "output_dtype")
+
+
+def _matmul_all_reduce_add_rms_norm(case, world):
+    m, n, k = int(case.get("m", 0)), int(case.get("n", 0)), int(case.get("k", 0))
+    x, wt, y = case.get("xDtype", "FP16"), case.get("weightDtype", "FP16"), case.get("yDtype", "FP16")
+    w = Workload("matmul", m=m, n=n, k=k, a_bytes=dtype_bytes(x), b_bytes=dtype_bytes(wt),
+                 c_bytes=dtype_bytes(y), precision=cube_class(wt if dtype_name(wt) == "INT4" else x))
+    # AddRmsNorm: 读 residual、读 reduce 结果、写 y 与 normOut
+    w.vector_bytes = int(4 * m * n * w.c_bytes)
+    w.comm = [CommPhase("allreduce", int(m * n * w.c_bytes), world)]
+    return w
+
+
+def _all_to_all_all_gather_batch_mat_mul(case, world):
+    shapes = case.get("input_shapes") or [[], []]
+    x, wt = shapes[0], shapes[1] if len(shapes) > 1 else []
+    dtypes = case.get("input_dtypes") or ["ge::DT_FLOAT16", "ge::DT_FLOAT16"]
+    ep, tp = int(case.get("ep_world_size", 1)), int(case.get("tp_world_size", 1))
+    if len(x) != 3 or len(wt) != 3:
+        return Workload("unknown")
+    experts, capacity, hidden = (int(v) for v in x)
+    batch = int(wt[0])
+    k, n = (int(wt[2]), int(wt[1])) if case.get("transpose_weight") else (int(wt[1]), int(wt[2]))
+    # alltoall 后每个本地专家收到 ep * C 个 token；沿 C 切分 (x_shard_type=1) 时 allgather 再扩大 tp 倍
+    tokens = experts * capacity // max(batch, 1)
+    m = tokens * (tp if case.get("x_shard_type") == 1 else 1)
+    w = Workload("matmul", batch=batch, m=m, n=n, k=k, a_bytes=dtype_bytes(dtypes[0]),
+                 b_bytes=dtype_bytes(dtypes[-1]), c_bytes=dtype_bytes(case.get("output_dtype")),
+                 precision=cube_class(dtypes[0]))
+    volume = int(experts * capacity * hidden * w.a_bytes)
+    w.comm = [CommPhase("alltoall", volume, ep)]
+    if tp > 1:
+        w.comm.append(CommPhase("allgather", volume, tp))
+    return w
+
+
+def _batch_mat_mul_reduce_scatter_allto_all(case, world):
+    x, wt = case.get("x_shape") or [], case.get("w_shape") or []
+    ep, tp = int(case.get("ep_world_size", 1)), int(case.get("tp_world_size", 1))
+    if len(x) != 3 or len(wt) != 3:
+        return Workload("unknown")
+    batch, m, k = (int(v) for v in x)
+    n = int(wt[1]) if case.get("transpose_weight") else int(wt[2])
+    w = Workload("matmul", batch=batch, m=m, n=n, k=k, a_bytes=dtype_bytes(case.get("x_dtype")),
+                 b_bytes=dtype_bytes(case.get("w_dtype")), c_bytes=dtype_bytes(case.get("y_dtype")),
+                 precision=cube_class(case.get("x_dtype")))
+    out = int(batch * m * n * w.c_bytes)
+    w.comm = [CommPhase("reducescatter", out, tp)] if tp > 1 else []
+    w.comm.append(CommPhase("alltoall", out // max(tp, 1), ep))
+    return w
+
+
+def _distribute_barrier(case, world):
+    return Workload("barrier", comm=[CommPhase("barrier", 0, int(case.get("world_size") or world))])
+
+
+def _moe(tokens: int, hidden: int, topk: int, dtype: Any, ep: int, tp: int, combine: bool,
+         quant: bool = False) -> Workload:
+    elem = 1 if quant else dtype_bytes(dtype)
+    # 量化后每个 token 额外携带一个 fp32 scale
+    token_bytes = hidden * elem + (4 if quant else 0)
+    volume = int(tokens * topk * token_bytes)
+    raw = int(tokens * topk * hidden * dtype_bytes(dtype)) if quant else 0
+    # 向量核按 token 行切分: m 为搬运的行数，k 为 hidden
+    w = Workload("moe", m=tokens * topk, k=hidden, a_bytes=dtype_bytes(dtype),
+                 vector_bytes=int(tokens * topk * hidden * dtype_bytes(dtype) * 2))
+    w.comm = [CommPhase("alltoallv", volume, ep, raw)]
+    if tp > 1:
+        w.comm.append(CommPhase("reducescatter" if combine else "allgather", volume, tp, raw))
+    return w
+
+
+def _moe_distribute_dispatch(case, world):
+    x = case.get("input0_shape") or [0, 0]
+    topk = int((case.get("input1_shape") or [0, 1])[-1])
+    return _moe(int(x[0]), int(x[-1]), topk, case.get("input0_dtype"), int(case.get("ep_world_size", world)),
+                int(case.get("tp_world_size", 1)), False, bool(case.get("quant_mode")))
+
+
+def _moe_distribute_combine(case, world):
+    # input0 为按专家展开后的 token，逐个返还给原 rank
+    x = case.get("input0_shape") or [0, 0]
+    return _moe(int(x[0]), int(x[-1]), 1, case.get("input0_dtype"), int(case.get("ep_world_size", world)),
+                int(case.get("tp_world_size", 1)), True, bool(case.get("comm_quant_mode")))
+
+
+def _literal(value: Any) -> Any:
+    if isinstance(value, str):
+        try:
+            return ast.literal_eval(value)
+        except (ValueError, SyntaxError):
+            return []
+    return value
+
+
+def case_fields(case: Dict[str, Any]) -> Dict[str, Any]:
+    """把结构化用例 (inputs / outputs / attrs 列表) 展平为与其他用例一致的
+    inputN_shape / inputN_dtype / outputN_shape / 属性名字段，已有的顶层字段优先"""
+    flat = {}
+    for kind in ("input", "output"):
+        for i, tensor in enumerate(_literal(case.get(f"{kind}s")) or []):
+            if isinstance(tensor, dict):
+                flat[f"{kind}{i}_shape"] = tensor.get("storage_shape") or []
+                flat[f"{kind}{i}_dtype"] = tensor.get("dtype")
+    for attr in _literal(case.get("attrs")) or []:
+        if isinstance(attr, dict) and attr.get("name"):
+            flat[attr["name"]] = attr.get("value")
+    flat.update(case)
+    return flat
+
+
+def _moe_distribute_combine_v2(case, world):
+    return _moe_distribute_combine(case_fields(case), world)
+
+
+# 与 template/test_allto_allv_grouped_mat_mul_tiling.cpp 中 TilingParams 的默认值一致
+ALLTO_ALLV_DEFAULTS = {"BSK": 4096, "H1": 7168, "A": 4096, "N1": 4096, "ep_world_size": 8, "e": 4,
+                       "gmm_weight_dim1": 7168}
+ALLTO_ALLV_DEFAULT_COUNTS = [128] * 32
+
+
+def _allto_allv_grouped_mat_mul(case, world):
+    params = dict(ALLTO_ALLV_DEFAULTS)
+    for pair in case.get("tiling_params_str_pair") or []:
+        try:
+            params[pair["key"]] = int(pair["value"])
+        except (ValueError, TypeError):
+            pass
+    # send_counts / recv_counts 为发往 / 来自每个 (rank, 专家) 的 token 数，取收发中较大的一侧；
+    # 用例没有覆盖时模板默认值之和即为 BSK
+    tokens = params["BSK"]
+    counts = {p.get("key"): p.get("value") for p in case.get("tiling_params_vec_pair") or []
+              if p.get("key") in ("send_counts", "recv_counts") and p.get("value")}
+    if counts:
+        tokens = max(sum(int(c) for c in counts.get(key, ALLTO_ALLV_DEFAULT_COUNTS))
+                     for key in ("send_counts", "recv_counts"))
+    w = Workload("grouped_matmul", m=params["A"], n=params["N1"], k=params["gmm_weight_dim1"])
+    w.comm = [CommPhase("alltoallv", int(tokens * params["H1"] * 2), params["ep_world_size"])]
+    return w
+
+
+WORKLOAD_BUILDERS = {
+    "all_gather_matmul": _all_gather_matmul,
+    "all_gather_matmul_v2": _all_gather_matmul,
+    "all_to_all_all_gather_batch_mat_mul": _all_to_all_all_gather_batch_mat_mul,
+    "allto_allv_grouped_mat_mul": _allto_allv_grouped_mat_mul,
+    "batch_mat_mul_reduce_scatter_allto_all": _batch_mat_mul_reduce_scatter_allto_all,
+    "distribute_barrier": _distribute_barrier,
+    "grouped_mat_mul_all_reduce": _grouped_mat_mul_all_reduce,
+    "matmul_all_reduce": _matmul_all_reduce,
+    "matmul_all_reduce_add_rms_norm": _matmul_all_reduce_add_rms_norm,
+    "matmul_reduce_scatter": _matmul_reduce_scatter,
+    "matmul_reduce_scatter_v2": _matmul_reduce_scatter,
+    "moe_distribute_combine": _moe_distribute_combine,
+    "moe_distribute_combine_v2": _moe_distribute_combine_v2,
+    "moe_distribute_dispatch": _moe_distribute_dispatch,
+    "moe_distribute_dispatch_v2": _moe_distribute_dispatch,
+}
+
+
+def workload_for_case(stem: str, case: Dict[str, Any], world: int = 8) -> Workload:
+    builder = WORKLOAD_BUILDERS.get(stem)
+    if builder is None:
+        return Workload("unknown")
+    try:
+        return builder(case, world)
+    except (ValueError, TypeError, IndexError, KeyError):
+        return Workload("unknown")
+
+
+@dataclass
+class Tiling:
+    source: str                     # decoded / nominal
+    base_m: int
+    base_n: int
+    base_k: int
+    used_cores: int
+    step_m: int = 1                 # L1 中同时驻留的 baseM 块数，B 矩阵在其间复用
+    step_n: int = 1
+    depth_a1: int = 2               # L1 中 A / B 的缓冲块数 (2 为 double buffer)
+    depth_b1: int = 2
+    db_l0a: int = 2                 # L0A / L0B / L0C 的缓冲块数
+    db_l0b: int = 2
+    db_l0c: int = 1
+    comm_tiles: int = 0             # MC2 通信与计算流水的切块数，0 表示未知
+    values: Dict[str, Any] = field(default_factory=dict)
+
+    def tiles(self, w: Workload) -> Tuple[int, int]:
+        return ceil_div(w.m, self.base_m), ceil_div(w.n, self.base_n)
+
+
+# 解码后的字段名 (不区分大小写，取路径最后一段) -> Tiling 属性；同名字段取第一次出现
+TILING_ALIASES = {
+    "base_m": ("basem",), "base_n": ("basen",), "base_k": ("basek",),
+    "used_cores": ("usedcorenum", "blockdim", "usecorenum"),
+    "step_m": ("stepm",), "step_n": ("stepn",), "depth_a1": ("deptha1",), "depth_b1": ("depthb1",),
+    "db_l0a": ("dbl0a",), "db_l0b": ("dbl0b",), "db_l0c": ("dbl0c",),
+    "comm_tiles": ("tilecnt", "commturn", "turnnum", "tilenum"),
+}
+TAIL_COUNT_ALIASES = ("tailcnt", "tailnum")
+
+
+def nominal_tiling(w: Workload, hw: Hardware) -> Tiling:
+    """按 L0 容量推导的典型 tile: L0C 放下 baseM x baseN 的 fp32 累加，L0A/L0B 放下双缓冲的 K 切片"""
+    base_m, base_n = 128, 256
+    if w.m and w.m < base_m:
+        base_m = max(16, ceil_div(w.m, 16) * 16)
+    if w.n and w.n < base_n:
+        base_n = max(16, ceil_div(w.n, 16) * 16)
+    while base_m * base_n * 4 > hw.l0c and base_n > 16:
+        base_n //= 2
+    elem = max(w.a_bytes, w.b_bytes, 0.5)
+    base_k = int(min(hw.l0a // (2 * base_m * elem), hw.l0b // (2 * base_n * elem)))
+    base_k = max(16, base_k // 16 * 16)
+    if w.k:
+        base_k = min(base_k, ceil_div(w.k, 16) * 16)
+    tasks = w.batch * ceil_div(w.m, base_m) * ceil_div(w.n, base_n)
+    return Tiling("nominal", base_m, base_n, base_k, max(1, min(hw.aic_num, tasks or 1)))
+
+
+def tiling_from_values(values: List[Tuple[str, Any]], w: Workload, hw: Hardware) -> Optional[Tiling]:
+    """从解码后的 (字段路径, 值) 中取 tile 决策；没有 baseM/baseN 时返回 None"""
+    leaf: Dict[str, Any] = {}
+    for path, value in values:
+        name = re.sub(r"\[\d+\]$", "", path.rsplit(".", 1)[-1]).lower()
+        if isinstance(value, (int, float)) and name not in leaf:
+            leaf[name] = value
+    found = {}
+    for attr, aliases in TILING_ALIASES.items():
+        value = next((leaf[a] for a in aliases if a in leaf), None)
+        if value:
+            found[attr] = int(value)
+    if "base_m" not in found or "base_n" not in found:
+        return None
+    nominal = nominal_tiling(w, hw)
+    found.setdefault("base_k", nominal.base_k)
+    found.setdefault("used_cores", nominal.used_cores)
+    tail = next((leaf[a] for a in TAIL_COUNT_ALIASES if a in leaf), 0)
+    if found.get("comm_tiles") and tail:
+        found["comm_tiles"] += int(tail)
+    return Tiling("decoded", values=dict(values), **found)
+
+
+@dataclass
+class CaseModel:
+    stem: str
+    op: str
+    name: str
+    case: Dict[str, Any]
+    hw: Hardware
+    workload: Workload
+    tiling: Optional[Tiling]
+
+    @property
+    def case_id(self) -> str:
+        return f"{self.op}/{self.name}"
+
+
+def expected_failure(case: Dict[str, Any]) -> bool:
+    """用例本身期望 tiling 失败 (非法参数用例)，这类用例没有 tiling 决策可分析"""
+    if case.get("expectSuccess") is False or "FAILED" in str(case.get("status", "")):
+        return True
+    if "InValid" in str(case.get("model_name", "")):
+        return True
+    return any(flag in case and not case[flag] for flag in ("hasExpectTilingKey", "has_expect_tiling_key"))
+
+
+class TilingSource:
+    """快照存储 + op_tiling 头文件解码；任一不可用时只给出名义 tile"""
+
+    def __init__(self, store: Optional[Path], ops_transformer: Optional[str], includes: List[str]):
+        self.store: Dict[str, dict] = {}
+        self.registry = None
+        if store is None:
+            return
+        from tiling_store import read_store
+        self.store = read_store(store)
+        from tiling_data_decoder import LayoutRegistry, DEFAULT_CACHE, find_headers
+        headers = find_headers(Path(ops_transformer), [Path(p) for p in includes]) if ops_transformer else []
+        if headers:
+            self.registry = LayoutRegistry(headers, DEFAULT_CACHE)
+
+    def decoded(self, model_op: str, case_id: str) -> Optional[List[Tuple[str, Any]]]:
+        entry = self.store.get(case_id)
+        if entry is None or self.registry is None:
+            return None
+        name = self.registry.struct_for_op(model_op)
+        if name is None:
+            return None
+        try:
+            return self.registry.decode(name, entry["data"])
+        except ValueError:
+            return None
+
+    def block_dim(self, case_id: str) -> Optional[int]:
+        entry = self.store.get(case_id)
+        return int(entry["blockDim"]) if entry and entry.get("blockDim") else None
+
+
+def load_models(source: Optional[TilingSource] = None, overrides: Optional[Dict[str, float]] = None,
+                ops: Optional[List[str]] = None, include_failures: bool = False) -> List[CaseModel]:
+    source = source or TilingSource(None, None, [])
+    op_names, ranks = probe_op_names(), mock_rank_nums()
+    models = []
+    for stem, cases in load_corpus().items():
+        op = op_names.get(stem, stem)
+        if ops and stem not in ops and op not in ops:
+            continue
+        for case in cases:
+            if not include_failures and expected_failure(case):
+                continue
+            models.append(build_model(stem, op, case, ranks.get(stem) or 8, source, overrides))
+    return models
+
+
+def build_model(stem: str, op: str, case: Dict[str, Any], world: int, source: Optional[TilingSource] = None,
+                overrides: Optional[Dict[str, float]] = None) -> CaseModel:
+    source = source or TilingSource(None, None, [])
+    hw = hardware_for_case(case, overrides)
+    workload = workload_for_case(stem, case, world)
+    model = CaseModel(stem, op, case_name(case), case, hw, workload, None)
+    if workload.has_cube:
+        values = source.decoded(op, model.case_id)
+        tiling = tiling_from_values(values, workload, hw) if values else None
+        if tiling is None:
+            tiling = nominal_tiling(workload, hw)
+            block_dim = source.block_dim(model.case_id)
+            if block_dim:
+                tiling.used_cores = min(block_dim, hw.aic_num)
+        model.tiling = tiling
+    return model
+
+
+def add_model_args(parser: argparse.ArgumentParser) -> None:
+    """各分析工具共用的命令行参数"""
+    parser.add_argument("--store", type=Path,
+                        help="UTGEN_TILING_RECORD 写出的快照存储，配合 --ops-transformer 解码实际 tiling；"
+                             "不指定时使用名义 tile")
+    parser.add_argument("--ops-transformer", default=None,
+                        help="ops-transformer 仓库路径，用于解码快照中的 tiling data (默认取 OPS_TRANSFORMER_DIR)")
+    parser.add_argument("--include", action="append", default=[],
+                        help="额外的 tiling 结构体头文件或目录，可多次指定")
+    parser.add_argument("--op", action="append", default=[],
+                        help="只分析指定算子 (JSONL 文件名或探针算子名)，可多次指定")
+    parser.add_argument("--hw", action="append", default=[], metavar="KEY=VALUE",
+                        help="覆盖硬件参数，如 --hw hbm_gbps=1800 --hw link_gbps=100")
+
+
+def source_from_args(args: argparse.Namespace) -> TilingSource:
+    ops_transformer = args.ops_transformer or os.environ.get("OPS_TRANSFORMER_DIR")
+    return TilingSource(args.store, ops_transformer, args.include)
+
+
+def models_from_args(args: argparse.Namespace, include_failures: bool = False) -> List[CaseModel]:
+    return load_models(source_from_args(args), parse_hw_overrides(args.hw), args.op, include_failures)
+
+
+def short_id(case_id: str, width: int) -> str:
+    """用例名过长时保留算子名与末尾 (用例名的区分部分通常在末尾)"""
+    if len(case_id) <= width:
+        return case_id
+    op, _, name = case_id.partition("/")
+    keep = width - len(op) - 4
+    return f"{op}/..{name[-keep:]}" if keep > 8 else case_id[:width - 2] + ".."
+
+
+def fmt_us(seconds: float) -> str:
+    us = seconds * 1e6
+    return f"{us:,.1f}us" if us < 1e5 else f"{us / 1e3:,.1f}ms"
+
+
+def fmt_bytes(n: float) -> str:
+    for unit in ("B", "KB", "MB", "GB"):
+        if abs(n) < 1024 or unit == "GB":
+            return f"{n:.0f}{unit}" if unit == "B" else f"{n:.1f}{unit}"
+        n /= 1024
+    return f"{n:.1f}GB"
@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+MC2 融合算子的计算 / 通信重叠估算
+
+MatmulAllReduce、AllGatherMatmul、MatmulReduceScatter 与 BatchMatMul / AlltoAll 等融合算子把矩阵沿 M 切成
+若干块，块间用流水把通信藏在计算之后。本工具按流水模型逐用例估算:
+  - 计算时间 C: utils/roofline.py 中按所选 tile 估算的 kernel 时间
+  - 通信时间 M: 各通信阶段 (见 case_model.py) 的数据量按通信算法系数与 --link-gbps 链路带宽折算，
+                每块另加一次启动时延；通信域大小取 Mc2Hcom::MockValues 的 rankNum 或用例字段
+  - 切块数 T:   解码后 tiling data 中的 tileCnt + tailCnt，其次为模板中的 comm_turn 属性 (非 0 时)，
+                都没有时取模型下使流水耗时最短的切块数 (此时只能发现切块无法弥补的暴露)
+  - 流水耗时:   c + (T - 1) * max(c, m) + m，c = C / T，m = M / T + 时延
+并给出重叠效率 (可隐藏部分中被隐藏的比例)、暴露的通信时间与使流水耗时最短的切块数。
+暴露通信占流水耗时超过 --threshold (默认 10%) 的用例被标记，分为三类:
+  - 通信受限: M > C，切块无法隐藏
+  - 启动时延: 数据量小，每块的通信启动时延占主导
+  - 流水开销: 切块过少或过多
+
+用法:
+  python3 utils/comm_overlap.py
+  python3 utils/comm_overlap.py --op matmul_all_reduce --link-gbps 28 --algo ring
+  python3 utils/comm_overlap.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer --json overlap.json
+"""
+
+import argparse
+import json
+import sys
+from collections import Counter
+from dataclasses import dataclass
+from typing import List, Optional, Tuple
+
+from case_corpus import template_attr_int
+from case_model import (CaseModel, CommPhase, add_model_args, ceil_div, fmt_bytes, fmt_us, models_from_args,
+                        short_id)
+from roofline import analyze
+
+DEFAULT_THRESHOLD = 0.10
+MAX_TILES = 64
+COMM_TURN_ATTRS = ["comm_turn", "commTurn"]
+
+
+def phase_time(phase: CommPhase, link_gbps: float, algo: str) -> Tuple[float, int]:
+    """返回 (传输时间 s, 串行通信步数)。fullmesh 下每个对端一条链路并行收发，ring 下逐跳转发"""
+    w, size, bw = phase.world, phase.bytes, link_gbps * 1e9
+    if w <= 1:
+        return 0.0, 0
+    if phase.pattern == "barrier":
+        return 0.0, 1 if algo == "fullmesh" else w - 1
+    if algo == "fullmesh":
+        per_link = {"allreduce": 2 * size / w, "allgather": size, "reducescatter": size / w,
+                    "alltoall": size / w, "alltoallv": size / w}.get(phase.pattern, size / w)
+        steps = 2 if phase.pattern == "allreduce" else 1
+        return per_link / bw, steps
+    per_link = {"allreduce": 2 * (w - 1) / w * size, "allgather": (w - 1) * size,
+                "reducescatter": (w - 1) / w * size}.get(phase.pattern, (w - 1) / w * size)
+    steps = 2 * (w - 1) if phase.pattern == "allreduce" else w - 1
+    return per_link / bw, steps
+
+
+def pipeline_time(compute: float, comm: float, latency: float, tiles: int) -> float:
+    c, m = compute / tiles, comm / tiles + latency
+    return c + (tiles - 1) * max(c, m) + m
+
+
+@dataclass
+class Overlap:
+    model: CaseModel
+    compute: float
+    comm: float
+    latency: float              # 每块的通信启动时延
+    tiles: int
+    tiles_source: str           # decoded / comm_turn / model
+    best_tiles: int
+
+    @property
+    def total(self) -> float:
+        return pipeline_time(self.compute, self.comm, self.latency, self.tiles)
+
+    @property
+    def best_total(self) -> float:
+        return pipeline_time(self.compute, self.comm, self.latency, self.best_tiles)
+
+    @property
+    def exposed(self) -> float:
+        return max(0.0, self.total - self.compute)
+
+    @property
+    def efficiency(self) -> float:
+        """可隐藏的 min(C, M) 中实际被隐藏的比例"""
+        hideable = min(self.compute, self.comm + self.latency * self.tiles)
+        if hideable <= 0:
+            return 1.0
+        serial = self.compute + self.comm + self.latency * self.tiles
+        return max(0.0, min(1.0, (serial - self.total) / hideable))
+
+    @property
+    def comm_bound(self) -> bool:
+        return self.comm > self.compute
+
+    def flagged(self, threshold: float) -> bool:
+        return self.total > 0 and self.exposed / self.total > threshold
+
+    def kind(self) -> str:
+        if self.latency * self.tiles > self.comm:
+            return "启动时延"
+        return "通信受限" if self.comm_bound else "流水开销"
+
+    def reason(self) -> str:
+        kind = self.kind()
+        if kind == "启动时延":
+            return (f"启动时延: 通信 {fmt_bytes(self.model.workload.comm_bytes)} 仅需 {fmt_us(self.comm)}，"
+                    f"{self.tiles} 块共 {fmt_us(self.latency * self.tiles)} 启动时延无法隐藏")
+        if kind == "通信受限":
+            return (f"通信受限: 通信 {fmt_bytes(self.model.workload.comm_bytes)} 需 {fmt_us(self.comm)}，"
+                    f"比计算长，切块无法隐藏")
+        if self.best_tiles == self.tiles:
+            return f"流水开销: 切块数 {self.tiles} 已最优，暴露部分为首尾块的通信"
+        return (f"流水开销: T={self.tiles} 时暴露 {self.exposed / self.total:.0%}，"
+                f"T={self.best_tiles} 可降至 {fmt_us(self.best_total)}")
+
+
+def comm_tiles(model: CaseModel) -> Tuple[int, str]:
+    if model.tiling and model.tiling.source == "decoded" and model.tiling.comm_tiles:
+        return model.tiling.comm_tiles, "decoded"
+    turn = template_attr_int(model.stem, COMM_TURN_ATTRS)
+    if turn:
+        return turn, "comm_turn"
+    return 0, "model"
+
+
+def estimate(model: CaseModel, link_gbps: Optional[float], algo: str) -> Overlap:
+    hw = model.hw
+    bw = link_gbps or hw.link_gbps
+    comm, latency = 0.0, 0.0
+    for phase in model.workload.comm:
+        seconds, steps = phase_time(phase, bw, algo)
+        comm += seconds
+        latency += steps * hw.link_latency_us * 1e-6
+    compute = analyze(model).t_tiling
+    # 切块沿 M 方向，块数不超过 M 方向的 tile 数
+    limit = max(1, min(MAX_TILES, ceil_div(model.workload.m, model.tiling.base_m)))
+    best = min(range(1, limit + 1), key=lambda t: pipeline_time(compute, comm, latency, t))
+    tiles, source = comm_tiles(model)
+    return Overlap(model, compute, comm, latency, tiles or best, source, best)
+
+
+def to_json(o: Overlap, threshold: float) -> dict:
+    w = o.model.workload
+    return {
+        "case": o.model.case_id, "soc": o.model.hw.soc,
+        "phases": [{"pattern": p.pattern, "bytes": p.bytes, "world": p.world} for p in w.comm],
+        "computeUs": round(o.compute * 1e6, 3), "commUs": round(o.comm * 1e6, 3),
+        "latencyUsPerTile": round(o.latency * 1e6, 3), "tiles": o.tiles, "tilesSource": o.tiles_source,
+        "pipelineUs": round(o.total * 1e6, 3), "exposedUs": round(o.exposed * 1e6, 3),
+        "efficiency": round(o.efficiency, 3), "commBound": o.comm_bound,
+        "bestTiles": o.best_tiles, "bestPipelineUs": round(o.best_total * 1e6, 3),
+        "flagged": o.flagged(threshold), "kind": o.kind(),
+    }
+
+
+def print_report(results: List[Overlap], threshold: float, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'通信':>22} {'计算耗时':>10} {'通信耗时':>10} {'T':>4} {'流水耗时':>10} "
+          f"{'暴露耗时':>10} {'重叠':>5}  最优T")
+    shown = results[:top] if top else results
+    for o in shown:
+        phases = "+".join(f"{p.pattern}x{p.world}" for p in o.model.workload.comm)
+        flagged = o.flagged(threshold)
+        mark = "⚠️ " if flagged else "   "
+        tiles = f"{o.tiles}" + {"decoded": "", "comm_turn": "c", "model": "*"}[o.tiles_source]
+        print(f"{mark}{short_id(o.model.case_id, 61):<61} {phases[:22]:>22} {fmt_us(o.compute):>10} "
+              f"{fmt_us(o.comm):>10} {tiles:>4} {fmt_us(o.total):>10} {fmt_us(o.exposed):>10} {o.efficiency:>5.0%}  {o.best_tiles}")
+        if flagged:
+            print(f"      {o.reason()}")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+    print("\nT 后缀: 无 = 解码的 tiling data, c = 模板 comm_turn 属性, * = 没有切块信息，取模型最优切块")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="MC2 融合算子的计算 / 通信重叠估算")
+    add_model_args(parser)
+    parser.add_argument("--link-gbps", type=float, help="单条链路带宽 GB/s (默认取 SoC 估计值)")
+    parser.add_argument("--algo", choices=("fullmesh", "ring"), default="fullmesh",
+                        help="通信算法 (默认 fullmesh)")
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD,
+                        help=f"暴露通信占流水耗时的比例阈值 (默认 {DEFAULT_THRESHOLD})")
+    parser.add_argument("--top", type=int, help="只列出暴露比例最高的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在被标记的用例时返回非零")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    fused = [m for m in models if m.workload.has_cube and m.workload.comm]
+    results = [estimate(m, args.link_gbps, args.algo) for m in fused]
+    results.sort(key=lambda o: o.exposed / o.total if o.total else 0.0, reverse=True)
+    print_report(results, args.threshold, args.top)
+
+    flagged = [o for o in results if o.flagged(args.threshold)]
+    kinds = Counter(o.kind() for o in flagged)
+    print(f"{len(results)} 个融合用例, {len(flagged)} 个暴露通信超过 {args.threshold:.0%}"
+          + (f" ({', '.join(f'{k} {n}' for k, n in kinds.most_common())})" if kinds else ""))
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(o, args.threshold) for o in results], f, ensure_ascii=False, indent=2)
+    sys.exit(1 if args.strict and flagged else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+通信量与带宽下限标注
+
+逐用例按解析式计算集合通信的数据量 (见 case_model.py 的各算子 Workload):
+  - AllGatherMatmul: 本 rank 的 x1 分片参与 allgather
+  - MatmulAllReduce / GroupedMatMulAllReduce / AddRmsNorm: 输出参与 allreduce，
+      配置了 comm_quant_scale 时按 int8 通信
+  - MatmulReduceScatter: 输出参与 reducescatter
+  - AlltoAllvGroupedMatMul: send_counts / recv_counts 的 token 数 x H1
+  - MoE dispatch / combine: token 数 x topK x hidden 在 ep_world_size 上 alltoallv，
+      tp_world_size > 1 时另有 tp 域的 allgather / reducescatter；quant_mode / comm_quant_mode 时按 int8 计
+再按通信算法系数与链路带宽折算带宽下限时间 (见 comm_overlap.py)，与计算时间
+(cube 用例取 roofline.py 的估算，MoE 取向量搬运时间) 比较，判断是否带宽受限，并给出通信量化节省的数据量比例与时间。
+不传输数据的用例 (如 distribute_barrier) 只有同步时延，单独计数，不判断带宽受限。
+
+结果既可以作为注释写入生成的测试用例 (python3 workflow.py --annotate-comm，
+同时在输出文件旁写出 <输出文件名>.comm.json)，也可以由本工具对整个语料输出报告。
+
+用法:
+  python3 utils/comm_volume.py
+  python3 utils/comm_volume.py --op moe_distribute_dispatch --link-gbps 28 --algo ring
+  python3 utils/comm_volume.py --json comm_volume.json
+"""
+
+import argparse
+import json
+import sys
+from typing import Any, Dict, List, Optional
+
+from case_corpus import mock_rank_nums, probe_op_names
+from case_model import (CaseModel, CommPhase, add_model_args, build_model, fmt_bytes, fmt_us, models_from_args,
+                        short_id)
+from comm_overlap import phase_time
+from roofline import analyze
+
+DEFAULT_ALGO = "fullmesh"
+
+
+def annotate(model: CaseModel, link_gbps: Optional[float] = None, algo: str = DEFAULT_ALGO) -> Optional[dict]:
+    """返回用例的通信标注；没有通信阶段的用例返回 None"""
+    w, hw = model.workload, model.hw
+    if not w.comm:
+        return None
+    bw = link_gbps or hw.link_gbps
+    phases, comm, raw_comm = [], 0.0, 0.0
+    for p in w.comm:
+        seconds, steps = phase_time(p, bw, algo)
+        latency = steps * hw.link_latency_us * 1e-6
+        raw_seconds = phase_time(CommPhase(p.pattern, p.raw_bytes, p.world), bw, algo)[0] if p.raw_bytes else seconds
+        phases.append({"pattern": p.pattern, "world": p.world, "bytes": p.bytes, "rawBytes": p.raw_bytes or p.bytes,
+                       "linkBytes": int(seconds * bw * 1e9), "timeUs": round((seconds + latency) * 1e6, 3)})
+        comm += seconds + latency
+        raw_comm += raw_seconds + latency
+    if w.has_cube:
+        compute = analyze(model).t_tiling
+    elif w.vector_bytes:
+        compute = w.vector_bytes / (hw.vector_gbps() * 1e9)
+    else:
+        compute = 0.0
+    raw_bytes = sum(p["rawBytes"] for p in phases)
+    return {
+        "case": model.case_id, "soc": model.hw.soc, "algo": algo, "linkGbps": bw, "phases": phases,
+        "bytes": w.comm_bytes, "commUs": round(comm * 1e6, 3), "rawCommUs": round(raw_comm * 1e6, 3),
+        "computeUs": round(compute * 1e6, 3),
+        "bandwidthBound": w.comm_bytes > 0 and comm > compute,
+        "quantSaving": round(1 - w.comm_bytes / raw_bytes, 3) if raw_bytes > w.comm_bytes else 0.0,
+    }
+
+
+def comment(note: dict) -> str:
+    if not note["bytes"]:
+        phases = " + ".join(f"{p['pattern']} x{p['world']}" for p in note["phases"])
+        return f"通信: {phases}, 同步时延 {fmt_us(note['commUs'] / 1e6)}"
+    phases = " + ".join(f"{p['pattern']} x{p['world']} {fmt_bytes(p['bytes'])}" for p in note["phases"])
+    text = f"通信: {phases}, 带宽下限 {fmt_us(note['commUs'] / 1e6)}"
+    if note["computeUs"]:
+        text += f" (计算 {fmt_us(note['computeUs'] / 1e6)}{', 带宽受限' if note['bandwidthBound'] else ''})"
+    if note["quantSaving"]:
+        text += f", 通信量化节省 {note['quantSaving']:.0%} ({fmt_us((note['rawCommUs'] - note['commUs']) / 1e6)})"
+    return text
+
+
+class CaseAnnotator:
+    """供生成器使用: 按 JSONL 文件名构建用例模型，返回每个用例的注释文本并收集报告"""
+
+    def __init__(self, stem: str, link_gbps: Optional[float] = None, algo: str = DEFAULT_ALGO):
+        self.stem = stem
+        self.op = probe_op_names().get(stem, stem)
+        self.world = mock_rank_nums().get(stem) or 8
+        self.link_gbps, self.algo = link_gbps, algo
+        self.report: List[dict] = []
+
+    def __call__(self, case: Dict[str, Any]) -> Optional[str]:
+        try:
+            note = annotate(build_model(self.stem, self.op, case, self.world), self.link_gbps, self.algo)
+        except (ValueError, TypeError, KeyError, IndexError, ZeroDivisionError):
+            return None
+        if note is None:
+            return None
+        self.report.append(note)
+        return comment(note)
+
+
+def print_report(notes: List[dict], top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'通信':>30} {'数据量':>10} {'通信耗时':>10} {'计算耗时':>10}  量化节省")
+    shown = notes[:top] if top else notes
+    for n in shown:
+        phases = "+".join(f"{p['pattern']}x{p['world']}" for p in n["phases"])
+        mark = "⚠️ " if n["bandwidthBound"] else "ℹ️ " if not n["bytes"] else "   "
+        saving = f"{n['quantSaving']:.0%}" if n["quantSaving"] else "-"
+        print(f"{mark}{short_id(n['case'], 61):<61} {phases[:30]:>30} {fmt_bytes(n['bytes']):>10} "
+              f"{fmt_us(n['commUs'] / 1e6):>10} {fmt_us(n['computeUs'] / 1e6):>10}  {saving}")
+    if top and len(notes) > top:
+        print(f"   ... 另有 {len(notes) - top} 个用例未列出")
+    if any(not n["bytes"] for n in shown):
+        print("\nℹ️ 不传输数据: 通信耗时只是同步时延，不判断带宽受限")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="通信量与带宽下限标注")
+    add_model_args(parser)
+    parser.add_argument("--link-gbps", type=float, help="单条链路带宽 GB/s (默认取 SoC 估计值)")
+    parser.add_argument("--algo", choices=("fullmesh", "ring"), default=DEFAULT_ALGO,
+                        help=f"通信算法 (默认 {DEFAULT_ALGO})")
+    parser.add_argument("--top", type=int, help="只列出通信时间最长的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    notes = [n for n in (annotate(m, args.link_gbps, args.algo) for m in models) if n]
+    notes.sort(key=lambda n: n["commUs"], reverse=True)
+    print_report(notes, args.top)
+
+    bound = [n for n in notes if n["bandwidthBound"]]
+    latency_only = [n for n in notes if not n["bytes"]]
+    quant = [n for n in notes if n["quantSaving"]]
+    print(f"\n{len(notes)} 个通信用例, {len(bound)} 个带宽受限, {len(latency_only)} 个只有同步时延, "
+          f"{len(quant)} 个使用通信量化"
+          + (f" (平均节省 {sum(n['quantSaving'] for n in quant) / len(quant):.0%})" if quant else ""))
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(notes, f, ensure_ascii=False, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -1615,14 +1615,52 @@ def parse_case_allto_allv_grouped_matmul(case_str: str) -> Dict[str, Any]:
     return res
 
 
+# MatmulAllReduceAddRmsNorm legacy caseName 中各段的含义（按顺序）
+ADD_RMS_NORM_CASE_NAME_FIELDS = [
+    ("model_name", str),
+    ("group_name", str),
+    ("reduce_op", str),
+    ("m", int),
+    ("k", int),
+    ("n", int),
+    ("biasFlag", int),
+    ("x3Flag", int),
+    ("transA", int),
+    ("transB", int),
+    ("group", int),
+    ("antiquant_offsetExistFlag", int),
+    ("antiquant_scaleExistFlag", int),
+    ("dequant_scaleExistFlag", int),
+    ("antigroupSize", int),
+    ("epsilon", float),
+    ("xDtype", str),
+    ("weightDtype", str),
+    ("biasDtype", str),
+    ("yDtype", str),
+]
+
+
+def parse_add_rms_norm_case_name(case_name: str) -> Dict[str, Any]:
+    """
+    将 MatmulAllReduceAddRmsNorm 的 legacy caseName 解码为字段字典。
+    格式如：
+    "MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16"
+
+    多余的段（如 "_CommTurn" 后缀）会被忽略；段数不足时返回空字典。
+    """
+    parts = case_name.split("_")
+    if len(parts) < len(ADD_RMS_NORM_CASE_NAME_FIELDS):
+        return {}
+    return {name: conv(part) for (name, conv), part in zip(ADD_RMS_NORM_CASE_NAME_FIELDS, parts)}
+
+
 def parse_case_matmul_all_reduce_add_rms_norm(case_str: str) -> Dict[str, Any]:
     """
     解析 MatmulAllReduceAddRmsNorm 的 TestParam 用例。
     字段顺序：
     caseName, blockDim, tilingKey
 
-    caseName 中编码了所有参数，格式如：
-    "MODEL0_group_sum_4096_688_4096_1_0_0_0_-1_0_0_1_0_0.1_INT8_INT8_INT32_BF16"
+    caseName 中编码了所有参数，由 parse_add_rms_norm_case_name 解码。
     """
     tokens = split_top_level_commas(case_str)
     if len(tokens) != 3:
@@ -1636,31 +1674,7 @@ def parse_case_matmul_all_reduce_add_rms_norm(case_str: str) -> Dict[str, Any]:
     res["case_name"] = case_name
     res["blockDim"] = parse_int(tokens[1])
     res["tilingKey"] = parse_int(tokens[2])
-
-    # 解析 caseName 中的参数
-    parts = case_name.split("_")
-    if len(parts) >= 20:
-        idx = 0
-        res["model_name"] = parts[idx]; idx += 1
-        res["group_name"] = parts[idx]; idx += 1
-        res["reduce_op"] = parts[idx]; idx += 1
-        res["m"] = int(parts[idx]); idx += 1
-        res["k"] = int(parts[idx]); idx += 1
-        res["n"] = int(parts[idx]); idx += 1
-        res["biasFlag"] = int(parts[idx]); idx += 1
-        res["x3Flag"] = int(parts[idx]); idx += 1
-        res["transA"] = int(parts[idx]); idx += 1
-        res["transB"] = int(parts[idx]); idx += 1
-        res["group"] = int(parts[idx]); idx += 1
-        res["antiquant_offsetExistFlag"] = int(parts[idx]); idx += 1
-        res["antiquant_scaleExistFlag"] = int(parts[idx]); idx += 1
-        res["dequant_scaleExistFlag"] = int(parts[idx]); idx += 1
-        res["antigroupSize"] = int(parts[idx]); idx += 1
-        res["epsilon"] = float(parts[idx]); idx += 1
-        res["xDtype"] = parts[idx]; idx += 1
-        res["weightDtype"] = parts[idx]; idx += 1
-        res["biasDtype"] = parts[idx]; idx += 1
-        res["yDtype"] = parts[idx]; idx += 1
+    res.update(parse_add_rms_norm_case_name(case_name))
 
     return res
 
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+核利用率与尾块不均衡分析
+
+奇异 shape (M=12290、N=0xFFFFFFF、local_tail_e、tile_short 等) 下，最后一轮 tile 往往只占用少数核，
+尾块本身也只有一小部分有效数据。本工具按用例的 tiling 决策 (见 case_model.py) 逐用例计算:
+  - cube 类用例: tile 数、每核 tile 数的最大 / 最小值、轮数、最后一轮的核占用率、
+                 M / N 方向尾块的填充率，以及按补齐后 tile 计价的有效核利用率
+  - 向量部分 (MoE 搬运、AddRmsNorm 等): 按行在 AIV 核上均分时的同一组指标
+并按浪费的核时间 (全部核 x 轮数 x 单任务耗时 - 有效工作时间) 排序，
+对 cube 类用例在 L0 容量约束下搜索利用率最高的 baseM / baseN 作为参考。
+
+用法:
+  python3 utils/core_utilization.py
+  python3 utils/core_utilization.py --top 20 --json core_util.json
+  python3 utils/core_utilization.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer
+"""
+
+import argparse
+import json
+import sys
+from dataclasses import dataclass
+from typing import List, Optional, Tuple
+
+from case_model import CaseModel, Hardware, Workload, add_model_args, ceil_div, fmt_us, models_from_args, short_id
+
+DEFAULT_LOW_UTIL = 0.8
+
+
+@dataclass
+class Utilization:
+    model: CaseModel
+    unit: str                   # cube / vector
+    tasks: int
+    cores: int                  # 可用的核数 (AIC 或 AIV)
+    used: int                   # 实际参与的核数
+    per_core_max: int
+    per_core_min: int
+    tail_occupancy: float       # 最后一轮中有任务的核占全部核的比例
+    m_tail_fill: float
+    n_tail_fill: float
+    utilization: float          # 有效工作 / (全部核 x 轮数 x 单任务耗时)
+    wasted: float               # 浪费的核时间 (s)
+    suggestion: Optional[Tuple[int, int, float]] = None
+
+    @property
+    def rounds(self) -> int:
+        return ceil_div(self.tasks, self.used) if self.used else 0
+
+
+def tail_fill(size: int, base: int) -> float:
+    rest = size % base
+    return rest / base if rest else 1.0
+
+
+def cube_util(w: Workload, hw: Hardware, base_m: int, base_n: int, base_k: int, used: int) -> Tuple[float, dict]:
+    tiles_m, tiles_n = ceil_div(w.m, base_m), ceil_div(w.n, base_n)
+    tasks = w.batch * tiles_m * tiles_n
+    used = max(1, min(used, hw.aic_num, tasks))
+    rounds = ceil_div(tasks, used)
+    per_core = hw.cube_tflops(w.precision) * 1e12 / hw.aic_num
+    k_padded = ceil_div(w.k, base_k) * base_k
+    t_tile = 2 * base_m * base_n * k_padded / per_core
+    useful = w.flops / per_core
+    available = rounds * hw.aic_num * t_tile
+    return useful / available if available else 1.0, {
+        "tasks": tasks, "used": used, "rounds": rounds, "wasted": available - useful}
+
+
+def best_tile(w: Workload, hw: Hardware, base_k: int) -> Tuple[int, int, float]:
+    """L0C 放得下 fp32 累加、L0A/L0B 放得下双缓冲 baseK 切片的 16 对齐 baseM/baseN 中利用率最高的一组"""
+    elem = max(w.a_bytes, w.b_bytes, 0.5)
+    best = (0, 0, -1.0)
+    for base_m in range(16, 257, 16):
+        for base_n in range(16, 513, 16):
+            if base_m * base_n * 4 > hw.l0c or 2 * base_m * base_k * elem > hw.l0a \
+                    or 2 * base_n * base_k * elem > hw.l0b:
+                continue
+            # 单 tile 太小时搬运开销占主导，至少保留 64x64
+            if base_m * base_n < 64 * 64 and (base_m < w.m or base_n < w.n):
+                continue
+            util, _ = cube_util(w, hw, base_m, base_n, base_k, hw.aic_num)
+            if util > best[2] + 1e-9:
+                best = (base_m, base_n, util)
+    return best
+
+
+def analyze_cube(model: CaseModel, suggest: bool) -> Utilization:
+    w, t, hw = model.workload, model.tiling, model.hw
+    util, info = cube_util(w, hw, t.base_m, t.base_n, t.base_k, t.used_cores)
+    tasks, used = info["tasks"], info["used"]
+    last = tasks - (info["rounds"] - 1) * used
+    result = Utilization(
+        model, "cube", tasks, hw.aic_num, used, ceil_div(tasks, used), tasks // used,
+        last / hw.aic_num, tail_fill(w.m, t.base_m), tail_fill(w.n, t.base_n), util, info["wasted"])
+    if suggest:
+        result.suggestion = best_tile(w, hw, t.base_k)
+    return result
+
+
+def analyze_vector(model: CaseModel) -> Utilization:
+    """向量部分 (MoE 搬运、AddRmsNorm 等) 按行在 AIV 核上均分，每行耗时按单核向量带宽计"""
+    w, hw = model.workload, model.hw
+    rows = w.batch * w.m
+    used = min(hw.aiv_num, rows)
+    rounds = ceil_div(rows, used)
+    t_row = w.vector_bytes / rows / (hw.vector_gbps(1) * 1e9)
+    available = rounds * hw.aiv_num * t_row
+    last = rows - (rounds - 1) * used
+    return Utilization(model, "vector", rows, hw.aiv_num, used, rounds, rows // used, last / hw.aiv_num,
+                       1.0, 1.0, rows / (rounds * hw.aiv_num), available - rows * t_row)
+
+
+def to_json(u: Utilization) -> dict:
+    data = {
+        "case": u.model.case_id, "unit": u.unit, "tasks": u.tasks, "cores": u.cores, "usedCores": u.used,
+        "rounds": u.rounds, "perCoreMax": u.per_core_max, "perCoreMin": u.per_core_min,
+        "tailOccupancy": round(u.tail_occupancy, 3), "mTailFill": round(u.m_tail_fill, 3),
+        "nTailFill": round(u.n_tail_fill, 3), "utilization": round(u.utilization, 3),
+        "wastedCoreUs": round(u.wasted * 1e6, 3),
+    }
+    if u.model.tiling:
+        data["tile"] = {"baseM": u.model.tiling.base_m, "baseN": u.model.tiling.base_n,
+                        "source": u.model.tiling.source}
+    if u.suggestion:
+        data["suggestion"] = {"baseM": u.suggestion[0], "baseN": u.suggestion[1],
+                              "utilization": round(u.suggestion[2], 3)}
+    return data
+
+
+def print_report(results: List[Utilization], low: float, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'类型':>6} {'任务':>9} {'核':>7} {'每核':>15} {'尾轮':>5} {'M尾':>5} {'N尾':>5} "
+          f"{'利用率':>6} {'浪费核时':>12}")
+    shown = results[:top] if top else results
+    for u in shown:
+        mark = "⚠️ " if u.utilization < low else "   "
+        per_core = f"{u.per_core_min}-{u.per_core_max}" if u.per_core_min != u.per_core_max else f"{u.per_core_max}"
+        print(f"{mark}{short_id(u.model.case_id, 61):<61} {u.unit:>6} {u.tasks:>9} {u.used:>3}/{u.cores:<3} "
+              f"{per_core:>15} {u.tail_occupancy:>5.0%} {u.m_tail_fill:>5.0%} {u.n_tail_fill:>5.0%} "
+              f"{u.utilization:>6.0%} {fmt_us(u.wasted):>12}")
+        if u.utilization < low and u.suggestion and u.suggestion[2] > u.utilization + 0.05:
+            t = u.model.tiling
+            print(f"      baseM x baseN {t.base_m}x{t.base_n} -> {u.suggestion[0]}x{u.suggestion[1]} "
+                  f"可将利用率提升到 {u.suggestion[2]:.0%}")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="核利用率与尾块不均衡分析")
+    add_model_args(parser)
+    parser.add_argument("--low", type=float, default=DEFAULT_LOW_UTIL,
+                        help=f"有效核利用率低于该值的用例被标记 (默认 {DEFAULT_LOW_UTIL})")
+    parser.add_argument("--no-suggest", action="store_true", help="不搜索替代的 baseM / baseN")
+    parser.add_argument("--top", type=int, help="只列出浪费核时间最多的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    results = []
+    for model in models:
+        if model.workload.has_cube:
+            results.append(analyze_cube(model, not args.no_suggest))
+        if model.workload.vector_bytes and model.workload.m:
+            results.append(analyze_vector(model))
+    results.sort(key=lambda u: u.wasted, reverse=True)
+    print_report(results, args.low, args.top)
+
+    low = [u for u in results if u.utilization < args.low]
+    print(f"\n{len(results)} 个用例, {len(low)} 个有效核利用率低于 {args.low:.0%}, "
+          f"合计浪费核时间 {sum(u.wasted for u in results) * 1e3:,.3f}ms")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(u) for u in results], f, ensure_ascii=False, indent=2)
+
+
+if __name__ == "__main__":
+    main()
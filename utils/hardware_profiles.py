@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+registry/hardware_profiles.yaml 硬件 profile 登记表的公共读取函数，供性能模型、生成器与 soc_compare.py 共用
+
+  - load_profiles:   读取并校验登记表，profile 名 -> HardwareProfile (保持登记顺序)
+  - select_profiles: 按逗号分隔的 profile 名选取，"all" 表示全部
+  - profile_for_soc: socVersion -> 登记的第一个对应 profile
+  - apply_profile:   把用例的硬件字段 (soc_version / coreNum / ubSize 与 compile_info 的 hardware_info)
+                     改写为 profile 的取值，用例名加上 _<profile 名> 后缀；profile 不是用例原本的硬件时
+                     期望值 (tiling key / 是否成功) 不再适用，标记为只记录结果 (recordOnly)
+  - is_home_profile: profile 是否与用例原本的 socVersion 与核数一致
+  - expand_cases:    每个用例按选定的 profile 各展开一份
+"""
+
+import copy
+import json
+import re
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Union
+
+try:
+    import yaml
+except ImportError:
+    print("❌ 缺少依赖 PyYAML (读取 registry/*.yaml 需要)，请先执行: pip install -r requirements.txt")
+    sys.exit(2)
+
+ROOT = Path(__file__).resolve().parent.parent
+DEFAULT_REGISTRY = ROOT / "registry" / "hardware_profiles.yaml"
+
+HARDWARE_KEYS = ("CORE_NUM", "UB_SIZE", "L1_SIZE", "L0A_SIZE", "L0B_SIZE", "L0C_SIZE", "L2_SIZE")
+PERF_KEYS = ("freq_ghz", "cube_flops_per_cycle", "vector_bytes_per_cycle", "hbm_gbps", "l2_gbps",
+             "l1_gbps_per_core", "link_gbps", "link_latency_us", "aiv_per_aic")
+CASE_NAME_FIELDS = ("case_name", "caseName", "test_name")
+# 展开后的用例上标记 "只记录 tiling 结果、不断言期望值" 的字段
+RECORD_ONLY_FIELD = "recordOnly"
+PROFILE_NAME_RE = re.compile(r"^\w+$")
+
+
+@dataclass
+class HardwareProfile:
+    name: str
+    soc_version: str
+    hardware_info: Dict[str, int]
+    perf: Dict[str, float]
+    note: str = ""
+
+    @property
+    def core_num(self) -> int:
+        return self.hardware_info["CORE_NUM"]
+
+    @property
+    def ub_size(self) -> int:
+        return self.hardware_info["UB_SIZE"]
+
+
+_CACHE: Dict[Path, Dict[str, HardwareProfile]] = {}
+
+
+def load_profiles(path: Path = DEFAULT_REGISTRY) -> Dict[str, HardwareProfile]:
+    path = Path(path).resolve()
+    if path in _CACHE:
+        return _CACHE[path]
+    raw = yaml.safe_load(path.read_text(encoding="utf-8")) or {}
+    profiles = {}
+    for name, entry in raw.items():
+        if not PROFILE_NAME_RE.match(str(name)):
+            raise ValueError(f"{path}: profile 名 {name!r} 只能包含字母、数字与下划线")
+        entry = entry or {}
+        info, perf = entry.get("hardware_info") or {}, entry.get("perf") or {}
+        missing = ([] if entry.get("soc_version") else ["soc_version"]) \
+            + [k for k in HARDWARE_KEYS if k not in info] + [k for k in PERF_KEYS if k not in perf]
+        if missing:
+            raise ValueError(f"{path}: profile {name} 缺少字段: {', '.join(missing)}")
+        profiles[str(name)] = HardwareProfile(
+            str(name), str(entry["soc_version"]), {k: int(info[k]) for k in HARDWARE_KEYS},
+            {k: float(perf[k]) for k in PERF_KEYS}, str(entry.get("note", "")))
+    if not profiles:
+        raise ValueError(f"{path}: 没有登记任何 profile")
+    _CACHE[path] = profiles
+    return profiles
+
+
+def select_profiles(names: Union[str, List[str]], path: Path = DEFAULT_REGISTRY) -> List[HardwareProfile]:
+    profiles = load_profiles(path)
+    if isinstance(names, str):
+        names = [n.strip() for n in names.split(",") if n.strip()]
+    if not names or names == ["all"]:
+        return list(profiles.values())
+    unknown = [n for n in names if n not in profiles]
+    if unknown:
+        raise ValueError(f"未登记的硬件 profile: {', '.join(unknown)} (可选: {', '.join(profiles)})")
+    return [profiles[n] for n in names]
+
+
+def profile_for_soc(soc: str, path: Path = DEFAULT_REGISTRY) -> Optional[HardwareProfile]:
+    profiles = load_profiles(path)
+    if soc in profiles:
+        return profiles[soc]
+    return next((p for p in profiles.values() if p.soc_version == soc), None)
+
+
+def case_hardware(case: Dict[str, Any]) -> Dict[str, Any]:
+    """用例原本的 socVersion 与核数，取自用例字段，没有时取自 compile_info 的 hardware_info"""
+    info: Dict[str, Any] = {}
+    text = case.get("compile_info")
+    if text:
+        info = (json.loads(text) if isinstance(text, str) else text).get("hardware_info", {})
+    return {"soc_version": case.get("soc_version", info.get("socVersion")),
+            "core_num": case.get("coreNum", info.get("CORE_NUM"))}
+
+
+def is_home_profile(case: Dict[str, Any], profile: HardwareProfile) -> bool:
+    """用例的期望值是在该硬件上得到的；用例没有给出核数时只比较 socVersion"""
+    hardware = case_hardware(case)
+    return hardware["soc_version"] == profile.soc_version and \
+        hardware["core_num"] in (None, profile.core_num)
+
+
+def apply_profile(case: Dict[str, Any], profile: HardwareProfile) -> Dict[str, Any]:
+    """返回改写了硬件字段的用例副本；compile_info 中 hardware_info 以外的内容保持不变"""
+    home = is_home_profile(case, profile)
+    case = copy.deepcopy(case)
+    if not home:
+        case[RECORD_ONLY_FIELD] = True
+    name_field = next((f for f in CASE_NAME_FIELDS if f in case), "case_name")
+    case[name_field] = f"{case.get(name_field, '')}_{profile.name}"
+    case["soc_version"] = profile.soc_version
+    case["coreNum"] = profile.core_num
+    case["ubSize"] = profile.ub_size
+    text = case.get("compile_info")
+    if text:
+        info = json.loads(text) if isinstance(text, str) else text
+        hardware = info.setdefault("hardware_info", {})
+        hardware.update(profile.hardware_info)
+        hardware["socVersion"] = profile.soc_version
+        case["compile_info"] = json.dumps(info) if isinstance(text, str) else info
+    return case
+
+
+def expand_cases(cases: List[Dict[str, Any]], profiles: List[HardwareProfile]) -> List[Dict[str, Any]]:
+    """用例按原顺序展开，同一用例的各 profile 副本相邻"""
+    return [apply_profile(case, profile) for case in cases for profile in profiles]
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+HCCL 通信窗口 (window buffer) 占用模型
+
+MC2 融合算子与 MoE dispatch / combine 把通信数据写入每个 rank 的 HCCL 窗口，窗口大小由 HCCL_BUFFSIZE
+(单位 MB，默认 200) 决定。本工具逐用例估算每个 rank 需要的窗口字节数并与 --hccl-buffsize 比较:
+  - MC2 matmul: 通信阶段的每 rank 数据量 (allgather 为收集后的 A，allreduce / reducescatter 为输出)；
+      win2win 用例 (用例名含 win2win) 的计算结果直接写入窗口，整块数据都要放得下，
+      否则退回经窗口分块搬运的路径；其余用例按通信切块 T (见 comm_overlap.py) 双缓冲，每块 2 x 数据量 / T
+  - MoE dispatch: 2 (双缓冲) x 本卡专家数 x maxBs x ep_world_size x token 槽位，
+      maxBs = ceil(global_bs / ep_world_size) (global_bs 为 0 时取本卡 bs)，
+      本卡专家数 = moe_expert_num / (ep_world_size - shared_expert_rank_num)，
+      token 槽位 = Align512(Align32(h x 数据类型字节) + 64)，quant_mode 非 0 时按 int8 计
+  - MoE combine: 2 x maxBs x (topK + shared_expert_num) x token 槽位，comm_quant_mode 非 0 时按 int8 计
+超出窗口的 MC2 用例会退回更慢的分块路径 (⚠️)，MoE 用例在部署时会因 HCCL_BUFFSIZE 过小直接报错 (❌)。
+--world 按部署规模替换通信域大小 (MoE 的 ep_world_size、MC2 allgather 的 rank 数) 重新估算。
+
+用法:
+  python3 utils/hccl_window.py
+  python3 utils/hccl_window.py --hccl-buffsize 512 --op moe_distribute_dispatch
+  python3 utils/hccl_window.py --world 64 --json window.json --strict
+"""
+
+import argparse
+import json
+import os
+import sys
+from dataclasses import dataclass
+from typing import List, Optional
+
+from case_model import CaseModel, add_model_args, case_fields, ceil_div, dtype_bytes, fmt_bytes, models_from_args, short_id
+from comm_overlap import estimate
+
+DEFAULT_BUFFSIZE_MB = 200
+MB = 1024 * 1024
+
+
+def align(value: float, to: int) -> int:
+    return ceil_div(int(value), to) * to
+
+
+def token_slot(hidden: int, elem: float) -> int:
+    return align(align(hidden * elem, 32) + 64, 512)
+
+
+@dataclass
+class Window:
+    model: CaseModel
+    need: int
+    world: int
+    path: str                   # win2win / 分块 / dispatch / combine
+    detail: str
+
+    @property
+    def moe(self) -> bool:
+        return self.path in ("dispatch", "combine")
+
+    def status(self, window: int) -> str:
+        if self.need <= window:
+            return "ok"
+        return "fail" if self.moe else "spill"
+
+
+def moe_window(model: CaseModel, world: Optional[int]) -> Optional[Window]:
+    f = case_fields(model.case)
+    combine = "combine" in model.stem
+    x = f.get("input0_shape") or []
+    ids = f.get("input1_shape") or []
+    if len(x) < 2 or not ids:
+        return None
+    hidden = int(x[-1])
+    bs, topk = (int(ids[0]), int(ids[-1])) if len(ids) > 1 else (int(x[0]), 1)
+    ep = int(world or f.get("ep_world_size") or 1)
+    shared_ranks = int(f.get("shared_expert_rank_num") or 0)
+    global_bs = int(f.get("global_bs") or 0)
+    max_bs = ceil_div(global_bs, ep) if global_bs else bs
+    if combine:
+        quant = bool(f.get("comm_quant_mode"))
+        elem = 1 if quant else dtype_bytes(f.get("input0_dtype"))
+        slots = max_bs * (topk + int(f.get("shared_expert_num") or 0))
+        detail = f"maxBs={max_bs} x (topK {topk} + 共享 {int(f.get('shared_expert_num') or 0)})"
+    else:
+        quant = bool(f.get("quant_mode"))
+        elem = 1 if quant else dtype_bytes(f.get("input0_dtype"))
+        local = max(1, ceil_div(int(f.get("moe_expert_num") or 1), max(1, ep - shared_ranks)))
+        slots = local * max_bs * ep
+        detail = f"本卡专家 {local} x maxBs={max_bs} x ep={ep}"
+    slot = token_slot(hidden, elem)
+    detail += f" x 槽位 {fmt_bytes(slot)}" + (" (int8)" if quant else "")
+    return Window(model, 2 * slots * slot, ep, "combine" if combine else "dispatch", detail)
+
+
+def mc2_window(model: CaseModel, world: Optional[int]) -> Optional[Window]:
+    w = model.workload
+    if not w.has_cube or not w.comm:
+        return None
+    phase = max(w.comm, key=lambda p: p.bytes)
+    data = phase.bytes
+    # allgather 收集全部 rank 的 A，窗口需求随通信域线性增长；allreduce / reducescatter 的每 rank 数据量不变
+    if world and phase.pattern == "allgather" and phase.world:
+        data = data * world // phase.world
+    size = world or phase.world
+    if "win2win" in model.name:
+        return Window(model, data, size, "win2win", f"{phase.pattern} 整块 {fmt_bytes(data)}")
+    tiles = max(1, estimate(model, None, "fullmesh").tiles)
+    chunk = ceil_div(data, tiles)
+    return Window(model, 2 * chunk, size, "分块", f"{phase.pattern} {fmt_bytes(data)} / T={tiles} x 2")
+
+
+def to_json(win: Window, window: int) -> dict:
+    return {
+        "case": win.model.case_id, "path": win.path, "world": win.world, "needBytes": win.need,
+        "windowBytes": window, "ratio": round(win.need / window, 3), "status": win.status(window),
+        "detail": win.detail,
+    }
+
+
+def print_report(results: List[Window], window: int, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'路径':>8} {'rank':>5} {'需要':>10} {'占窗口':>7}  明细")
+    shown = results[:top] if top else results
+    for win in shown:
+        mark = {"ok": "   ", "spill": "⚠️ ", "fail": "❌ "}[win.status(window)]
+        print(f"{mark}{short_id(win.model.case_id, 61):<61} {win.path:>8} {win.world:>5} {fmt_bytes(win.need):>10} "
+              f"{win.need / window:>7.0%}  {win.detail}")
+        if win.status(window) == "spill":
+            hint = "退回经窗口分块搬运的路径" if win.path == "win2win" else "需要更多通信切块"
+            print(f"      超出窗口 {fmt_bytes(win.need - window)}，{hint}")
+        elif win.status(window) == "fail":
+            print(f"      HCCL_BUFFSIZE 至少需要 {ceil_div(win.need, MB)}MB，部署时会报错")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="HCCL 通信窗口占用模型")
+    add_model_args(parser)
+    parser.add_argument("--hccl-buffsize", type=int, default=int(os.environ.get("HCCL_BUFFSIZE", DEFAULT_BUFFSIZE_MB)),
+                        help=f"每个 rank 的 HCCL 窗口大小 MB (默认取环境变量 HCCL_BUFFSIZE，未设置时 {DEFAULT_BUFFSIZE_MB})")
+    parser.add_argument("--world", type=int, help="按该通信域大小 (部署规模) 重新估算")
+    parser.add_argument("--top", type=int, help="只列出窗口占用最高的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在超出窗口的用例时返回非零")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    window = args.hccl_buffsize * MB
+    results = []
+    for model in models:
+        win = moe_window(model, args.world) if model.workload.kind == "moe" else mc2_window(model, args.world)
+        if win:
+            results.append(win)
+    results.sort(key=lambda win: win.need, reverse=True)
+    print_report(results, window, args.top)
+
+    spill = [win for win in results if win.status(window) == "spill"]
+    fail = [win for win in results if win.status(window) == "fail"]
+    print(f"\nHCCL 窗口 {args.hccl_buffsize}MB: {len(results)} 个用例, {len(spill)} 个 MC2 用例超出窗口, "
+          f"{len(fail)} 个 MoE 用例窗口不足")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(win, window) for win in results], f, ensure_ascii=False, indent=2)
+    sys.exit(1 if args.strict and (spill or fail) else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling 性能回归门禁
+
+按 ops-transformer 的 commit 把 tiling 耗时样本保存到本地 SQLite，
+新一次运行与最近若干次运行组成的滚动基线比较：
+  - 每个用例取 新/基线 的中位数之比，算子级别取各用例比值的几何平均；
+  - 用 bootstrap (在每个用例内对新旧样本分别重采样) 估计比值的置信区间；
+  - 置信区间下界仍超过 1 + threshold 的算子判定为回归，门禁失败。
+
+样本来源 (自动识别):
+  - 生成用例在 UTGEN_REPORT_DIR 下写出的 tiling_latency.json (见 utgen_tiling_probe.h)
+  - bench_<op>_tiling 的 Google Benchmark JSON 输出 (--benchmark_out_format=json)
+
+用法:
+  python3 utils/perf_gate.py record --repo /workspace/ops-transformer-dev report/tiling_latency.json
+  python3 utils/perf_gate.py check  --repo /workspace/ops-transformer-dev report/tiling_latency.json --record
+  python3 utils/perf_gate.py history
+"""
+
+import argparse
+import json
+import math
+import random
+import sqlite3
+import statistics
+import subprocess
+import sys
+from collections import defaultdict
+from datetime import datetime
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+DEFAULT_DB = Path(__file__).resolve().parent.parent / "perf_history.sqlite"
+DEFAULT_BASELINE_RUNS = 5
+DEFAULT_THRESHOLD = 0.10
+DEFAULT_CONFIDENCE = 0.95
+DEFAULT_BOOTSTRAP = 2000
+
+# Google Benchmark time_unit -> ns
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+SCHEMA = """
+CREATE TABLE IF NOT EXISTS runs (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    commit_sha TEXT NOT NULL,
+    recorded_at TEXT NOT NULL,
+    source TEXT NOT NULL
+);
+CREATE TABLE IF NOT EXISTS samples (
+    run_id INTEGER NOT NULL REFERENCES runs(id),
+    op TEXT NOT NULL,
+    case_name TEXT NOT NULL,
+    ns REAL NOT NULL
+);
+CREATE INDEX IF NOT EXISTS samples_run ON samples(run_id);
+"""
+
+# (op, case) -> 样本 (ns)
+Samples = Dict[Tuple[str, str], List[float]]
+
+
+def load_samples(path: Path) -> Samples:
+    """读取 tiling_latency.json 或 Google Benchmark JSON"""
+    data = json.loads(path.read_text(encoding="utf-8"))
+    samples: Samples = defaultdict(list)
+    if isinstance(data, list):
+        for item in data:
+            samples[(item["op"], item["case"])].append(float(item["ns"]))
+    elif isinstance(data, dict) and "benchmarks" in data:
+        for bench in data["benchmarks"]:
+            # 只取每次重复的原始结果，mean/median 等聚合行不作为样本
+            if bench.get("run_type", "iteration") != "iteration" or bench.get("error_occurred"):
+                continue
+            name = bench.get("run_name", bench["name"]).split("/repeats:")[0]
+            op, _, case_name = name.partition("/")
+            scale = TIME_UNIT_NS[bench.get("time_unit", "ns")]
+            samples[(op, case_name)].append(float(bench["real_time"]) * scale)
+    else:
+        raise ValueError(f"无法识别的样本文件格式: {path}")
+    return samples
+
+
+def resolve_commit(commit: Optional[str], repo: Optional[str]) -> str:
+    if commit:
+        return commit
+    if repo:
+        result = subprocess.run(["git", "-C", repo, "rev-parse", "HEAD"], capture_output=True, text=True)
+        if result.returncode == 0:
+            return result.stdout.strip()
+        raise RuntimeError(f"无法获取 {repo} 的 commit: {result.stderr.strip()}")
+    raise RuntimeError("请通过 --commit 或 --repo 指定 ops-transformer 的 commit")
+
+
+def open_db(path: Path) -> sqlite3.Connection:
+    conn = sqlite3.connect(str(path))
+    conn.executescript(SCHEMA)
+    return conn
+
+
+def record_run(conn: sqlite3.Connection, commit: str, source: Path, samples: Samples) -> int:
+    cursor = conn.execute(
+        "INSERT INTO runs (commit_sha, recorded_at, source) VALUES (?, ?, ?)",
+        (commit, datetime.now().isoformat(timespec="seconds"), str(source)),
+    )
+    run_id = cursor.lastrowid
+    conn.executemany(
+        "INSERT INTO samples (run_id, op, case_name, ns) VALUES (?, ?, ?, ?)",
+        [(run_id, op, case_name, ns) for (op, case_name), values in samples.items() for ns in values],
+    )
+    conn.commit()
+    return run_id
+
+
+def load_baseline(conn: sqlite3.Connection, commit: str, runs: int) -> Tuple[List[str], Samples]:
+    """最近 runs 次 (排除当前 commit) 运行的样本合并为基线"""
+    rows = conn.execute(
+        "SELECT id, commit_sha FROM runs WHERE commit_sha != ? ORDER BY id DESC LIMIT ?", (commit, runs)
+    ).fetchall()
+    baseline: Samples = defaultdict(list)
+    for run_id, _ in rows:
+        for op, case_name, ns in conn.execute("SELECT op, case_name, ns FROM samples WHERE run_id = ?", (run_id,)):
+            baseline[(op, case_name)].append(ns)
+    return [sha for _, sha in rows], baseline
+
+
+def percentile(sorted_values: List[float], q: float) -> float:
+    if not sorted_values:
+        return float("nan")
+    pos = q * (len(sorted_values) - 1)
+    low = math.floor(pos)
+    high = min(low + 1, len(sorted_values) - 1)
+    return sorted_values[low] + (sorted_values[high] - sorted_values[low]) * (pos - low)
+
+
+def operator_ratio(pairs: List[Tuple[List[float], List[float]]]) -> float:
+    """各用例 新/基线 中位数之比的几何平均"""
+    logs = [math.log(statistics.median(new) / statistics.median(base)) for new, base in pairs]
+    return math.exp(sum(logs) / len(logs))
+
+
+def bootstrap_ci(pairs: List[Tuple[List[float], List[float]]], iterations: int, confidence: float,
+                 rng: random.Random) -> Tuple[float, float]:
+    estimates = []
+    for _ in range(iterations):
+        resampled = [(rng.choices(new, k=len(new)), rng.choices(base, k=len(base))) for new, base in pairs]
+        estimates.append(operator_ratio(resampled))
+    estimates.sort()
+    alpha = (1.0 - confidence) / 2
+    return percentile(estimates, alpha), percentile(estimates, 1.0 - alpha)
+
+
+def compare(current: Samples, baseline: Samples, threshold: float, confidence: float,
+            iterations: int, seed: int) -> List[dict]:
+    rng = random.Random(seed)
+    by_op: Dict[str, List[Tuple[str, List[float], List[float]]]] = defaultdict(list)
+    for (op, case_name), values in current.items():
+        base = [ns for ns in baseline.get((op, case_name), []) if ns > 0]
+        values = [ns for ns in values if ns > 0]
+        if values and base:
+            by_op[op].append((case_name, values, base))
+
+    results = []
+    for op in sorted(by_op):
+        cases = by_op[op]
+        pairs = [(new, base) for _, new, base in cases]
+        ratio = operator_ratio(pairs)
+        low, high = bootstrap_ci(pairs, iterations, confidence, rng)
+        worst = max(cases, key=lambda c: statistics.median(c[1]) / statistics.median(c[2]))
+        results.append({
+            "op": op,
+            "cases": len(cases),
+            "ratio": ratio,
+            "ci_low": low,
+            "ci_high": high,
+            "regressed": low > 1.0 + threshold,
+            "worst_case": worst[0],
+            "worst_ratio": statistics.median(worst[1]) / statistics.median(worst[2]),
+        })
+    return results
+
+
+def print_results(results: List[dict], threshold: float, confidence: float) -> None:
+    print(f"{'算子':<28} {'用例':>5} {'比值':>8} {f'{confidence:.0%} CI':>19}  最慢用例")
+    for r in results:
+        mark = "❌" if r["regressed"] else "  "
+        print(f"{mark}{r['op']:<26} {r['cases']:>5} {r['ratio']:>8.3f} "
+              f"[{r['ci_low']:>7.3f}, {r['ci_high']:>7.3f}]  {r['worst_case']} ({r['worst_ratio']:.3f})")
+    regressed = [r["op"] for r in results if r["regressed"]]
+    if regressed:
+        print(f"\n❌ {len(regressed)} 个算子 tiling 耗时回归超过 {threshold:.0%}: {', '.join(regressed)}")
+    else:
+        print(f"\n✅ 没有算子的 tiling 耗时回归超过 {threshold:.0%}")
+
+
+def cmd_record(args) -> int:
+    commit = resolve_commit(args.commit, args.repo)
+    samples = load_samples(args.source)
+    conn = open_db(args.db)
+    try:
+        run_id = record_run(conn, commit, args.source, samples)
+    finally:
+        conn.close()
+    print(f"已记录 run {run_id}: commit {commit[:12]}, {len(samples)} 个用例")
+    return 0
+
+
+def cmd_check(args) -> int:
+    commit = resolve_commit(args.commit, args.repo)
+    current = load_samples(args.source)
+    conn = open_db(args.db)
+    try:
+        baseline_commits, baseline = load_baseline(conn, commit, args.baseline_runs)
+        if not baseline_commits:
+            print("⚠️  历史记录为空，没有可比较的基线，本次跳过门禁")
+            results = []
+        else:
+            print(f"基线: 最近 {len(baseline_commits)} 次运行 "
+                  f"({', '.join(sha[:12] for sha in baseline_commits)})")
+            results = compare(current, baseline, args.threshold, args.confidence, args.bootstrap, args.seed)
+            print_results(results, args.threshold, args.confidence)
+        if args.json:
+            args.json.write_text(json.dumps({"commit": commit, "baseline": baseline_commits, "operators": results},
+                                            ensure_ascii=False, indent=2), encoding="utf-8")
+        regressed = any(r["regressed"] for r in results)
+        # 回归的运行不进入历史，避免基线被逐步拉高
+        if args.record and not regressed:
+            record_run(conn, commit, args.source, current)
+    finally:
+        conn.close()
+    return 1 if regressed else 0
+
+
+def cmd_history(args) -> int:
+    conn = open_db(args.db)
+    try:
+        rows = conn.execute(
+            "SELECT runs.id, commit_sha, recorded_at, COUNT(samples.run_id) FROM runs "
+            "LEFT JOIN samples ON samples.run_id = runs.id GROUP BY runs.id ORDER BY runs.id DESC LIMIT ?",
+            (args.limit,),
+        ).fetchall()
+    finally:
+        conn.close()
+    for run_id, sha, recorded_at, count in rows:
+        print(f"{run_id:>5}  {sha[:12]:<12}  {recorded_at}  {count} 个样本")
+    return 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="tiling 性能回归门禁：按 commit 记录耗时历史并与滚动基线比较")
+    parser.add_argument("--db", type=Path, default=DEFAULT_DB, help=f"历史记录 SQLite 文件 (默认 {DEFAULT_DB.name})")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def add_source_args(p):
+        p.add_argument("source", type=Path, help="tiling_latency.json 或 Google Benchmark JSON")
+        p.add_argument("--commit", help="ops-transformer 的 commit")
+        p.add_argument("--repo", help="ops-transformer 仓库路径，未指定 --commit 时取其 HEAD")
+
+    p_record = sub.add_parser("record", help="记录一次运行")
+    add_source_args(p_record)
+    p_record.set_defaults(func=cmd_record)
+
+    p_check = sub.add_parser("check", help="与滚动基线比较，回归时返回非零")
+    add_source_args(p_check)
+    p_check.add_argument("--baseline-runs", type=int, default=DEFAULT_BASELINE_RUNS,
+                         help=f"基线取最近多少次运行 (默认 {DEFAULT_BASELINE_RUNS})")
+    p_check.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD,
+                         help=f"允许的耗时增长比例 (默认 {DEFAULT_THRESHOLD})")
+    p_check.add_argument("--confidence", type=float, default=DEFAULT_CONFIDENCE,
+                         help=f"bootstrap 置信水平 (默认 {DEFAULT_CONFIDENCE})")
+    p_check.add_argument("--bootstrap", type=int, default=DEFAULT_BOOTSTRAP,
+                         help=f"bootstrap 重采样次数 (默认 {DEFAULT_BOOTSTRAP})")
+    p_check.add_argument("--seed", type=int, default=0, help="bootstrap 随机种子")
+    p_check.add_argument("--json", type=Path, help="把比较结果写入 JSON 文件")
+    p_check.add_argument("--record", action="store_true", help="门禁通过后把本次运行写入历史")
+    p_check.set_defaults(func=cmd_check)
+
+    p_history = sub.add_parser("history", help="列出最近的运行")
+    p_history.add_argument("--limit", type=int, default=20)
+    p_history.set_defaults(func=cmd_history)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (RuntimeError, ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
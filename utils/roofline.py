@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling 决策的 roofline 代价模型
+
+结合用例的 shape / dtype、tiling 决策 (快照存储解码结果，或按片上容量推导的名义 tile，见 case_model.py)
+与 compile_info 中的硬件参数，逐用例估算:
+  - FLOPs 与算术强度 (FLOPs / HBM 字节)
+  - 各级存储的数据量: HBM、L2 -> L1 (按 tile 重复读取 A/B 面板)、L1 -> L0
+  - roofline 下界: max(FLOPs / 峰值算力, 必要数据量 / HBM 带宽)
+  - 按所选 tile 的估算耗时: 计算按 "任务轮数 x 单 tile 补齐后的 FLOPs" 计，与各级搬运取最大值
+估算耗时超过下界 --threshold 倍 (默认 1.5) 的用例被标记，并给出主要原因 (核利用率、tile 补齐、
+工作集超出 L2 后的重复读取、L1 带宽)；估算耗时不足 --min-us (默认 1us) 的小用例以启动开销为主，不标记。
+只有 tile 取自快照存储解码结果的用例才会被标记；名义 tile 的倍数只是估算，报告中以 ℹ️ 注明，不计入 --strict。
+没有 cube 计算的用例 (MoE 搬运、barrier、空 tensor) 跳过。
+
+用法:
+  python3 utils/roofline.py
+  python3 utils/roofline.py --op matmul_all_reduce --threshold 1.2 --top 20
+  python3 utils/roofline.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer --json roofline.json
+  python3 utils/roofline.py --hw hbm_gbps=1800 --strict
+"""
+
+import argparse
+import json
+import sys
+from dataclasses import dataclass
+from typing import List, Optional
+
+from case_model import (CaseModel, add_model_args, ceil_div, fmt_bytes, fmt_us, models_from_args, short_id)
+
+DEFAULT_THRESHOLD = 1.5
+DEFAULT_MIN_US = 1.0
+
+
+@dataclass
+class Roofline:
+    model: CaseModel
+    flops: int
+    compulsory_bytes: float
+    hbm_bytes: float
+    l2_bytes: float
+    l0_bytes: float
+    intensity: float
+    ridge: float
+    t_bound: float
+    t_compute: float
+    t_hbm: float
+    t_l2: float
+    t_l1: float
+    core_util: float
+    pad_util: float
+
+    @property
+    def t_tiling(self) -> float:
+        return max(self.t_compute, self.t_hbm, self.t_l2, self.t_l1)
+
+    @property
+    def gap(self) -> float:
+        return self.t_tiling / self.t_bound if self.t_bound else 1.0
+
+    @property
+    def nominal(self) -> bool:
+        return self.model.tiling.source != "decoded"
+
+    def over_bound(self, threshold: float, min_us: float) -> bool:
+        return self.gap > threshold and self.t_tiling * 1e6 >= min_us
+
+    def flagged(self, threshold: float, min_us: float) -> bool:
+        """名义 tile 并非 tiling 的真实决策，与下界的差距不能归咎于 tiling，不标记"""
+        return not self.nominal and self.over_bound(threshold, min_us)
+
+    @property
+    def limiter(self) -> str:
+        times = {"cube": self.t_compute, "HBM": self.t_hbm, "L2": self.t_l2, "L1": self.t_l1}
+        return max(times, key=times.get)
+
+    def reasons(self) -> List[str]:
+        found = []
+        if self.core_util < 0.8:
+            found.append(f"核利用率 {self.core_util:.0%}")
+        if self.pad_util < 0.8:
+            found.append(f"tile 补齐后有效计算 {self.pad_util:.0%}")
+        if self.hbm_bytes > self.compulsory_bytes * 1.5:
+            found.append(f"工作集超出 L2，HBM 读取为必要量的 {self.hbm_bytes / self.compulsory_bytes:.1f} 倍")
+        if self.limiter in ("L2", "L1"):
+            found.append(f"{self.limiter} 带宽受限")
+        return found
+
+
+def hbm_traffic(w, t, hw, tiles_m: int, tiles_n: int, cores: int, rounds: int) -> float:
+    """A/B 的 HBM 读取量：工作集放得下 L2 时只读一次；否则按行优先分配 tile，
+    A 的行面板在相邻轮次间留在 L2 中只读一次，B 放不下半个 L2 时每轮重新读取该轮覆盖的列面板"""
+    a_total = w.m * w.k * w.a_bytes
+    b_total = w.k * w.n * w.b_bytes
+    if a_total + b_total <= hw.l2 or b_total <= hw.l2 / 2:
+        return w.batch * (a_total + b_total)
+    per_round = min(cores, tiles_n) * min(t.base_n, w.n) * w.k * w.b_bytes
+    b_reads = max(b_total * w.batch, rounds * per_round)
+    return w.batch * a_total + b_reads
+
+
+def analyze(model: CaseModel) -> Roofline:
+    w, t, hw = model.workload, model.tiling, model.hw
+    peak = hw.cube_tflops(w.precision) * 1e12
+    per_core = peak / hw.aic_num
+    compulsory = w.batch * (w.m * w.k * w.a_bytes + w.k * w.n * w.b_bytes + w.m * w.n * w.c_bytes)
+    t_bound = max(w.flops / peak, compulsory / (hw.hbm_gbps * 1e9))
+
+    tiles_m, tiles_n = t.tiles(w)
+    tasks = w.batch * tiles_m * tiles_n
+    cores = max(1, min(t.used_cores, hw.aic_num, tasks))
+    rounds = ceil_div(tasks, cores)
+    k_padded = ceil_div(w.k, t.base_k) * t.base_k
+    task_flops = 2 * t.base_m * t.base_n * k_padded
+    t_compute = rounds * task_flops / per_core
+
+    # 每个 tile 从 L2 读取 A 的 baseM x K 面板与 B 的 K x baseN 面板，stepM/stepN 块之间在 L1 中复用
+    l2_reads = w.batch * (ceil_div(tiles_n, t.step_n) * w.m * w.k * w.a_bytes
+                          + ceil_div(tiles_m, t.step_m) * w.n * w.k * w.b_bytes)
+    output = w.batch * w.m * w.n * w.c_bytes
+    hbm_bytes = hbm_traffic(w, t, hw, tiles_m, tiles_n, cores, rounds) + output
+    l0_bytes = w.batch * (tiles_n * w.m * w.k * w.a_bytes + tiles_m * w.n * w.k * w.b_bytes)
+
+    return Roofline(
+        model=model, flops=w.flops, compulsory_bytes=compulsory, hbm_bytes=hbm_bytes,
+        l2_bytes=l2_reads + output, l0_bytes=l0_bytes,
+        intensity=w.flops / hbm_bytes if hbm_bytes else 0.0, ridge=peak / (hw.hbm_gbps * 1e9),
+        t_bound=t_bound, t_compute=t_compute, t_hbm=hbm_bytes / (hw.hbm_gbps * 1e9),
+        t_l2=(l2_reads + output) / (hw.l2_gbps * 1e9), t_l1=l0_bytes / (cores * hw.l1_gbps_per_core * 1e9),
+        core_util=tasks / (rounds * hw.aic_num), pad_util=w.flops / (tasks * task_flops) if tasks else 1.0)
+
+
+def to_json(r: Roofline, threshold: float, min_us: float) -> dict:
+    m, w, t = r.model, r.model.workload, r.model.tiling
+    return {
+        "case": m.case_id, "soc": m.hw.soc, "shape": {"batch": w.batch, "m": w.m, "n": w.n, "k": w.k},
+        "precision": w.precision, "tilingSource": t.source, "estimate": r.nominal,
+        "tile": {"baseM": t.base_m, "baseN": t.base_n, "baseK": t.base_k, "usedCores": t.used_cores},
+        "flops": r.flops, "bytes": {"compulsory": r.compulsory_bytes, "hbm": r.hbm_bytes, "l2ToL1": r.l2_bytes,
+                                    "l1ToL0": r.l0_bytes},
+        "intensity": round(r.intensity, 2), "ridge": round(r.ridge, 2),
+        "boundUs": round(r.t_bound * 1e6, 3), "tilingUs": round(r.t_tiling * 1e6, 3), "gap": round(r.gap, 3),
+        "limiter": r.limiter, "coreUtil": round(r.core_util, 3), "padUtil": round(r.pad_util, 3),
+        "flagged": r.flagged(threshold, min_us), "reasons": r.reasons(),
+    }
+
+
+def print_report(results: List[Roofline], threshold: float, min_us: float, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'B x M x N x K':>26} {'tile':>14} {'AI':>7} {'下界':>10} {'估算':>10} "
+          f"{'倍数':>6}  受限")
+    shown = results[:top] if top else results
+    for r in shown:
+        w, t = r.model.workload, r.model.tiling
+        shape = f"{w.batch}x{w.m}x{w.n}x{w.k}"
+        tile = f"{t.base_m}x{t.base_n}x{t.base_k}" + ("*" if r.nominal else "")
+        flagged = r.flagged(threshold, min_us)
+        mark = "⚠️ " if flagged else "ℹ️ " if r.over_bound(threshold, min_us) else "   "
+        print(f"{mark}{short_id(r.model.case_id, 61):<61} {shape:>26} {tile:>14} {r.intensity:>7.0f} "
+              f"{fmt_us(r.t_bound):>10} {fmt_us(r.t_tiling):>10} {r.gap:>6.2f}  {r.limiter}")
+        if flagged:
+            print(f"      {'; '.join(r.reasons()) or '多个因素叠加'}  "
+                  f"(HBM {fmt_bytes(r.hbm_bytes)}, L2->L1 {fmt_bytes(r.l2_bytes)})")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+    if any(r.nominal for r in shown):
+        print("\n* 名义 tile: 没有快照存储或无法解码 tiling data 时按 L0 容量推导，倍数仅为估算 (ℹ️)，不标记")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="tiling 决策的 roofline 代价模型")
+    add_model_args(parser)
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD,
+                        help=f"估算耗时超过下界的倍数阈值 (默认 {DEFAULT_THRESHOLD})")
+    parser.add_argument("--min-us", type=float, default=DEFAULT_MIN_US,
+                        help=f"估算耗时低于该值 (us) 的用例不标记 (默认 {DEFAULT_MIN_US})")
+    parser.add_argument("--top", type=int, help="只列出差距最大的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在被标记的用例时返回非零")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    cube = [m for m in models if m.workload.has_cube]
+    results = sorted((analyze(m) for m in cube), key=lambda r: r.gap, reverse=True)
+    print_report(results, args.threshold, args.min_us, args.top)
+
+    flagged = [r for r in results if r.flagged(args.threshold, args.min_us)]
+    estimated = [r for r in results if r.nominal and r.over_bound(args.threshold, args.min_us)]
+    socs = sorted({f"{m.hw.soc} {m.hw.aic_num} 核 ({m.hw.cube_tflops():.0f} TFLOPS fp16, HBM {m.hw.hbm_gbps:.0f} GB/s)"
+                   for m in cube})
+    print(f"\n硬件: {'; '.join(socs)}")
+    print(f"{len(results)} 个用例, {len(flagged)} 个超过下界 {args.threshold} 倍, "
+          f"{len(estimated)} 个名义 tile 用例的估算倍数超过阈值 (未标记), "
+          f"{len(models) - len(cube)} 个没有 cube 计算的用例跳过")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(r, args.threshold, args.min_us) for r in results], f, ensure_ascii=False, indent=2)
+    sys.exit(1 if args.strict and flagged else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+AIC / AIV 核调度的离散事件模拟器
+
+按用例的 tiling 决策 (见 case_model.py) 把矩阵切成 batch x ceil(M/baseM) x ceil(N/baseN) 个 tile，
+按 tile 序号轮转分配到 usedCoreNum 个 cube 核 (与 kernel 中 blockIdx 步进一致)，逐事件回放:
+  - MTE2:  从 L2 搬入 A/B 面板，各核平分 L2 带宽 (未命中 L2 的比例取 roofline 模型的 HBM / L2 数据量之比，
+           按 HBM 带宽折算)；L1 中有 depthA1 个缓冲时搬运与计算重叠
+  - Cube:  tile 补齐到 16 对齐后的 FLOPs / 单核峰值
+  - Vector: 配对的 2 个 AIV 核处理输出 tile 的后处理 (反量化、AddRmsNorm 等 vector_bytes 的分摊)
+  - Comm:  M 方向每凑齐一块 (切块数取 utils/comm_overlap.py 的结果) 即提交一次通信，通信引擎串行执行
+输出每个用例的预测完成时间、各类核的忙碌比例与暴露的通信时间，并与 roofline 估算对比；
+--trace-dir 为每个用例写出 Chrome trace JSON，可直接在 https://ui.perfetto.dev 打开查看逐核时间线。
+tile 数超过 --max-tiles 时把同一核上相邻的 tile 合并为一个事件，时间线的粒度随之变粗。
+
+语料中的用例互相独立，用 --jobs 个进程并行模拟。
+
+用法:
+  python3 utils/schedule_sim.py
+  python3 utils/schedule_sim.py --op matmul_all_reduce --trace-dir sim_traces --jobs 8
+  python3 utils/schedule_sim.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer --json sim.json
+"""
+
+import argparse
+import heapq
+import json
+import os
+import re
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Callable, Dict, List, Optional
+
+from case_model import CaseModel, add_model_args, ceil_div, fmt_us, models_from_args, short_id
+from comm_overlap import estimate
+from roofline import analyze
+
+DEFAULT_MAX_TILES = 20000
+
+
+class Simulator:
+    """最小的离散事件内核: 按时间顺序执行回调，同一时刻按提交顺序"""
+
+    def __init__(self):
+        self.now = 0.0
+        self._queue = []
+        self._seq = 0
+
+    def at(self, time: float, callback: Callable, *args) -> None:
+        heapq.heappush(self._queue, (time, self._seq, callback, args))
+        self._seq += 1
+
+    def run(self) -> None:
+        while self._queue:
+            self.now, _, callback, args = heapq.heappop(self._queue)
+            callback(*args)
+
+
+class Pipe:
+    """串行执行单元 (某个核的 MTE2 / Cube / Vector，或通信引擎)，记录忙碌区间"""
+
+    def __init__(self, name: str, trace: Optional[list]):
+        self.name = name
+        self.free_at = 0.0
+        self.busy = 0.0
+        self.trace = trace
+
+    def run(self, sim: Simulator, duration: float, label: str, done: Callable, *args) -> None:
+        start = max(sim.now, self.free_at)
+        self.free_at = start + duration
+        self.busy += duration
+        if self.trace is not None and duration > 0:
+            self.trace.append({"name": label, "ph": "X", "ts": start * 1e6, "dur": duration * 1e6,
+                               "pid": 0, "tid": self.name})
+        sim.at(self.free_at, done, *args)
+
+
+class CoreSchedule:
+    """一个 cube 核及其配对的 vector 核上的 tile 流水"""
+
+    def __init__(self, sim: Simulator, index: int, tiles: List[dict], slots: int, ctx: "CaseSim"):
+        self.sim, self.tiles, self.ctx = sim, tiles, ctx
+        self.mte = Pipe(f"AIC{index:02d}.MTE2", ctx.trace)
+        self.cube = Pipe(f"AIC{index:02d}.Cube", ctx.trace)
+        self.vec = Pipe(f"AIV{index * 2:02d}-{index * 2 + 1:02d}", ctx.trace)
+        self.slots = slots
+        self.next_load = 0
+
+    def start(self) -> None:
+        for _ in range(min(self.slots, len(self.tiles))):
+            self._issue_load()
+
+    def _issue_load(self) -> None:
+        if self.next_load >= len(self.tiles):
+            return
+        tile = self.tiles[self.next_load]
+        self.next_load += 1
+        self.mte.run(self.sim, tile["load"], f"load {tile['id']}", self._loaded, tile)
+
+    def _loaded(self, tile: dict) -> None:
+        self.cube.run(self.sim, tile["cube"], f"mmad {tile['id']}", self._computed, tile)
+
+    def _computed(self, tile: dict) -> None:
+        self._issue_load()      # 计算完成后释放 L1 缓冲
+        self.vec.run(self.sim, tile["vec"], f"epilogue {tile['id']}", self.ctx.tile_done, tile)
+
+
+class CaseSim:
+    def __init__(self, model: CaseModel, max_tiles: int, with_trace: bool):
+        self.model = model
+        self.trace: Optional[list] = [] if with_trace else None
+        self.sim = Simulator()
+        w, t, hw = model.workload, model.tiling, model.hw
+        overlap = estimate(model, None, "fullmesh")
+        self.chunks = max(1, overlap.tiles)
+        self.comm_per_chunk = overlap.comm / self.chunks + overlap.latency
+        self.comm = Pipe("Comm", self.trace)
+
+        tiles_m, tiles_n = t.tiles(w)
+        total = w.batch * tiles_m * tiles_n
+        self.tile_count = total
+        cores = max(1, min(t.used_cores, hw.aic_num, total))
+        self.cores = cores
+        group = ceil_div(total, max_tiles) if total > max_tiles else 1
+        self.group = group
+
+        per_core_flops = hw.cube_tflops(w.precision) * 1e12 / hw.aic_num
+        # 搬入的数据中有 hbm_bytes / l2_bytes 的比例未命中 L2，每字节的耗时取 L2 与 HBM 份额中较慢的一个
+        self.roofline = analyze(model)
+        miss = self.roofline.hbm_bytes / self.roofline.l2_bytes if self.roofline.l2_bytes else 1.0
+        mte_bw = min(hw.l2_gbps, hw.hbm_gbps / max(miss, 1e-9)) * 1e9 / cores
+        vec_bw = 2 * hw.freq_ghz * 1e9 * hw.vector_bytes_per_cycle
+        k_padded = ceil_div(w.k, t.base_k) * t.base_k
+        extra_vec = w.vector_bytes / total if total else 0.0
+
+        def tile_cost(mi: int, ni: int, count: int = 1) -> tuple:
+            bm = min(t.base_m, w.m - mi * t.base_m)
+            bn = min(t.base_n, w.n - ni * t.base_n)
+            load = (bm * w.k * w.a_bytes + w.k * bn * w.b_bytes) / mte_bw
+            cube = 2 * ceil_div(bm, 16) * 16 * ceil_div(bn, 16) * 16 * k_padded / per_core_flops
+            vec = (bm * bn * w.c_bytes + extra_vec) / vec_bw
+            return load * count, cube * count, vec * count
+
+        # 每个核上的 tile 序列；合并时同一核上相邻的 group 个 tile 为一个事件，按整块 tile 计价，
+        # 归属于其中最后一个 tile 所在的通信块
+        self.tiles_n, self.tiles_m = tiles_n, tiles_m
+        self.chunk_rows = ceil_div(tiles_m, self.chunks)
+        self.chunk_pending: Dict[int, int] = {}
+        per_core: List[List[dict]] = [[] for _ in range(cores)]
+        for core in range(cores):
+            ids = range(core, total, cores)
+            for start in range(0, len(ids), group):
+                members = ids[start:start + group]
+                last = members[-1]
+                if group == 1:
+                    cost = tile_cost((last // tiles_n) % tiles_m, last % tiles_n)
+                else:
+                    cost = tile_cost(0, 0, len(members))
+                chunk = self.chunk_of(last)
+                self.chunk_pending[chunk] = self.chunk_pending.get(chunk, 0) + 1
+                label = f"#{members[0]}" + (f"+{len(members) - 1}" if group > 1 else "")
+                per_core[core].append({"id": label, "load": cost[0], "cube": cost[1], "vec": cost[2],
+                                       "chunk": chunk})
+        slots = max(1, min(t.depth_a1, t.depth_b1))
+        self.schedules = [CoreSchedule(self.sim, i, tiles, slots, self) for i, tiles in enumerate(per_core)]
+        self.last_tile = 0.0
+        self.done_at = 0.0
+
+    def chunk_of(self, tile_id: int) -> int:
+        return ((tile_id // self.tiles_n) % self.tiles_m) // self.chunk_rows
+
+    def tile_done(self, tile: dict) -> None:
+        self.last_tile = max(self.last_tile, self.sim.now)
+        chunk = tile["chunk"]
+        self.chunk_pending[chunk] -= 1
+        if self.chunk_pending[chunk] == 0 and self.model.workload.comm:
+            self.comm.run(self.sim, self.comm_per_chunk, f"comm chunk {chunk}", self._comm_done)
+
+    def _comm_done(self) -> None:
+        self.done_at = max(self.done_at, self.sim.now)
+
+    def run(self) -> dict:
+        for schedule in self.schedules:
+            schedule.start()
+        self.sim.run()
+        makespan = max(self.last_tile, self.done_at)
+        hw = self.model.hw
+        cube_busy = sum(s.cube.busy for s in self.schedules)
+        vec_busy = sum(s.vec.busy for s in self.schedules)
+        roofline = self.roofline.t_tiling
+        return {
+            "case": self.model.case_id, "tiles": self.tile_count, "merged": self.group, "cores": self.cores,
+            "chunks": self.chunks if self.model.workload.comm else 0,
+            "makespanUs": makespan * 1e6, "computeEndUs": self.last_tile * 1e6,
+            "exposedCommUs": max(0.0, makespan - self.last_tile) * 1e6,
+            "cubeBusy": cube_busy / (makespan * hw.aic_num) if makespan else 0.0,
+            "aivBusy": vec_busy * 2 / (makespan * hw.aiv_num) if makespan else 0.0,
+            "rooflineUs": roofline * 1e6,
+        }
+
+    def write_trace(self, path: Path) -> None:
+        names = sorted({e["tid"] for e in self.trace})
+        tids = {name: i for i, name in enumerate(names)}
+        events = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": self.model.case_id}}]
+        events += [{"name": "thread_name", "ph": "M", "pid": 0, "tid": i, "args": {"name": name}}
+                   for name, i in tids.items()]
+        events += [dict(e, tid=tids[e["tid"]]) for e in self.trace]
+        path.write_text(json.dumps({"traceEvents": events, "displayTimeUnit": "ns"}), encoding="utf-8")
+
+
+def simulate(model: CaseModel, max_tiles: int, trace_dir: Optional[str]) -> dict:
+    case = CaseSim(model, max_tiles, trace_dir is not None)
+    result = case.run()
+    if trace_dir:
+        name = re.sub(r"[^\w.-]+", "_", model.case_id) + ".json"
+        case.write_trace(Path(trace_dir) / name)
+        result["trace"] = str(Path(trace_dir) / name)
+    return result
+
+
+def print_report(results: List[dict], top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'tiles':>9} {'核':>3} {'块':>3} {'完成时间':>11} {'暴露通信':>11} "
+          f"{'Cube忙':>7} {'AIV忙':>6} {'/roofline':>9}")
+    shown = results[:top] if top else results
+    for r in shown:
+        tiles = f"{r['tiles']}" + (f"/{r['merged']}" if r["merged"] > 1 else "")
+        ratio = r["makespanUs"] / r["rooflineUs"] if r["rooflineUs"] else 0.0
+        print(f"   {short_id(r['case'], 61):<61} {tiles:>9} {r['cores']:>3} {r['chunks']:>3} "
+              f"{fmt_us(r['makespanUs'] / 1e6):>11} {fmt_us(r['exposedCommUs'] / 1e6):>11} "
+              f"{r['cubeBusy']:>7.0%} {r['aivBusy']:>6.0%} {ratio:>9.2f}")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="AIC / AIV 核调度的离散事件模拟器")
+    add_model_args(parser)
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="并行模拟的进程数 (默认 CPU 核数)")
+    parser.add_argument("--max-tiles", type=int, default=DEFAULT_MAX_TILES,
+                        help=f"每个用例模拟的最多事件数，超过时合并相邻 tile (默认 {DEFAULT_MAX_TILES})")
+    parser.add_argument("--trace-dir", help="为每个用例写出 Perfetto 可读的 Chrome trace JSON 的目录")
+    parser.add_argument("--top", type=int, help="只列出完成时间最长的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果写入 JSON 文件")
+    args = parser.parse_args()
+
+    try:
+        models = [m for m in models_from_args(args) if m.workload.has_cube]
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    if args.trace_dir:
+        Path(args.trace_dir).mkdir(parents=True, exist_ok=True)
+    with ProcessPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        results = list(pool.map(simulate, models, [args.max_tiles] * len(models),
+                                [args.trace_dir] * len(models)))
+    results.sort(key=lambda r: r["makespanUs"], reverse=True)
+    print_report(results, args.top)
+    print(f"\n{len(results)} 个用例, {args.jobs} 个进程"
+          + (f", 时间线写入 {args.trace_dir}/" if args.trace_dir else ""))
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(results, f, ensure_ascii=False, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+跨 SoC 的 tiling 决策比较
+
+每个用例按 registry/hardware_profiles.yaml 中选定的硬件 profile (默认全部) 各展开一份
+(与 python3 workflow.py --soc-profiles 生成的用例一致，见 hardware_profiles.py)，逐 profile 给出:
+  - tiling key / block dim: 取自快照存储 (--store，由 --soc-profiles 生成的用例在 UTGEN_TILING_RECORD 下写出，
+      用例名带 _<profile> 后缀)；没有快照时 tiling key 记为 -，block dim 取名义 tile 占用的核数
+  - 估算耗时: 该 profile 上自己的 tiling 决策的代价模型耗时 (cube 用例同 tiling_tuner.py 的打分，
+      其余用例取通信带宽下限与向量搬运时间的较大者，见 comm_volume.py)
+  - 沿用耗时: 把用例在原 SoC (用例自身的 soc_version / compile_info) 上的 tiling 决策原样搬到该 profile 的耗时，
+      与该 profile 自己的决策相比慢出 --min-loss (默认 10%) 以上时标记，即按一种芯片调好的 tiling 在另一种芯片上吃亏的用例；
+      没有快照存储时两侧都是名义 tile，差别只来自核数，损失记为 "名义" 不标记
+--soc-profiles 展开时非原 SoC 的用例只记录结果、不断言期望值，tiling key 随 SoC 变化的用例在汇总中单独计数。
+
+用法:
+  python3 utils/soc_compare.py
+  python3 utils/soc_compare.py --profiles Ascend910B,Ascend910B_24C --op matmul_all_reduce
+  python3 utils/soc_compare.py --store golden/soc.store --ops-transformer /path/to/ops-transformer --json soc.json
+"""
+
+import argparse
+import json
+import sys
+from dataclasses import dataclass, field, replace
+from typing import Dict, List, Optional
+
+from case_corpus import load_corpus, mock_rank_nums, probe_op_names
+from case_model import (CaseModel, TilingSource, add_model_args, build_model, expected_failure, fmt_us,
+                        parse_hw_overrides, short_id, source_from_args)
+from comm_volume import annotate
+from hardware_profiles import HardwareProfile, apply_profile, select_profiles
+from tiling_tuner import score
+
+DEFAULT_MIN_LOSS = 0.10
+
+
+def estimate_time(model: CaseModel) -> float:
+    if model.workload.has_cube:
+        return score(model)
+    w, hw = model.workload, model.hw
+    vector = w.vector_bytes / (hw.vector_gbps() * 1e9) if w.vector_bytes else 0.0
+    note = annotate(model)
+    return max(vector, note["commUs"] / 1e6 if note else 0.0)
+
+
+@dataclass
+class ProfileResult:
+    profile: HardwareProfile
+    model: CaseModel
+    tiling_key: Optional[int]
+    block_dim: Optional[int]
+    time: float
+    ported: float               # 沿用原 SoC 的 tiling 决策时的耗时
+    nominal: bool               # 原 SoC 或该 profile 的 tiling 为名义 tile，损失只反映核数差异
+
+    @property
+    def loss(self) -> float:
+        return self.ported / self.time - 1 if self.time else 0.0
+
+    def underperforms(self, min_loss: float) -> bool:
+        return not self.nominal and self.loss > min_loss
+
+
+@dataclass
+class Comparison:
+    home: CaseModel
+    results: List[ProfileResult] = field(default_factory=list)
+
+    @property
+    def worst(self) -> float:
+        return max((r.loss for r in self.results if not r.nominal), default=0.0)
+
+    @property
+    def key_varies(self) -> bool:
+        keys = {r.tiling_key for r in self.results if r.tiling_key is not None}
+        return len(keys) > 1
+
+
+def compare_case(stem: str, op: str, case: dict, world: int, profiles: List[HardwareProfile],
+                 source: TilingSource, overrides: Dict[str, float]) -> Comparison:
+    home = build_model(stem, op, case, world, source, overrides)
+    comparison = Comparison(home)
+    for profile in profiles:
+        model = build_model(stem, op, apply_profile(case, profile), world, source, overrides)
+        entry = source.store.get(model.case_id)
+        tiling_key = int(entry["tilingKey"]) if entry else None
+        block_dim = source.block_dim(model.case_id) or (model.tiling.used_cores if model.tiling else None)
+        time = estimate_time(model)
+        ported = time
+        nominal = False
+        if home.tiling is not None and model.tiling is not None:
+            moved = replace(home.tiling, used_cores=min(home.tiling.used_cores, model.hw.aic_num))
+            ported = estimate_time(replace(model, tiling=moved))
+            nominal = "decoded" not in (home.tiling.source, model.tiling.source) or \
+                home.tiling.source != model.tiling.source
+        comparison.results.append(ProfileResult(profile, model, tiling_key, block_dim, time, ported, nominal))
+    return comparison
+
+
+def compare_corpus(profiles: List[HardwareProfile], source: TilingSource, overrides: Dict[str, float],
+                   ops: List[str]) -> List[Comparison]:
+    op_names, ranks = probe_op_names(), mock_rank_nums()
+    comparisons = []
+    for stem, cases in load_corpus().items():
+        op = op_names.get(stem, stem)
+        if ops and stem not in ops and op not in ops:
+            continue
+        for case in cases:
+            if not expected_failure(case):
+                comparisons.append(compare_case(stem, op, case, ranks.get(stem) or 8, profiles, source, overrides))
+    return comparisons
+
+
+def to_json(c: Comparison, min_loss: float) -> dict:
+    return {
+        "case": c.home.case_id, "homeSoc": c.home.hw.soc, "homeCores": c.home.hw.aic_num,
+        "tilingKeyVaries": c.key_varies,
+        "profiles": {r.profile.name: {
+            "socVersion": r.profile.soc_version, "coreNum": r.profile.core_num, "tilingKey": r.tiling_key,
+            "blockDim": r.block_dim, "tilingSource": r.model.tiling.source if r.model.tiling else None,
+            "estimatedUs": round(r.time * 1e6, 3), "portedUs": round(r.ported * 1e6, 3),
+            "loss": round(r.loss, 3), "nominal": r.nominal, "underperforms": r.underperforms(min_loss),
+        } for r in c.results},
+    }
+
+
+def print_report(comparisons: List[Comparison], min_loss: float, top: Optional[int]) -> None:
+    print(f"{'用例 / profile':<64} {'tiling key':>20} {'block':>6} {'估算':>11} {'沿用原 tiling':>16} {'损失':>6}")
+    shown = comparisons[:top] if top else comparisons
+    for c in shown:
+        mark = "⚠️ " if c.worst > min_loss else "ℹ️ " if c.key_varies else "   "
+        print(f"{mark}{short_id(c.home.case_id, 61):<61}  (原 SoC {c.home.hw.soc}, {c.home.hw.aic_num} 核)")
+        for r in c.results:
+            key = str(r.tiling_key) if r.tiling_key is not None else "-"
+            block = str(r.block_dim) if r.block_dim is not None else "-"
+            flag = " ⚠️" if r.underperforms(min_loss) else " (名义)" if r.nominal else ""
+            print(f"      {r.profile.name:<58} {key:>20} {block:>6} {fmt_us(r.time):>11} {fmt_us(r.ported):>16} "
+                  f"{r.loss:>6.0%}{flag}")
+    if top and len(comparisons) > top:
+        print(f"   ... 另有 {len(comparisons) - top} 个用例未列出")
+    if any(r.nominal for c in shown for r in c.results):
+        print("\n(名义): 没有快照存储或无法解码 tiling data，两侧都是按片上容量推导的名义 tile，"
+              "损失只来自核数差异，不标记")
+
+
+def print_summary(comparisons: List[Comparison], profiles: List[HardwareProfile], min_loss: float) -> None:
+    print(f"\n{'profile':<20} {'socVersion':<14} {'核数':>4} {'合计估算':>12} {'沿用原 tiling':>14} {'吃亏用例':>8}")
+    for i, profile in enumerate(profiles):
+        results = [c.results[i] for c in comparisons]
+        total, ported = sum(r.time for r in results), sum(r.ported for r in results)
+        worse = sum(1 for r in results if r.underperforms(min_loss))
+        print(f"{profile.name:<20} {profile.soc_version:<14} {profile.core_num:>4} {total * 1e3:>10,.3f}ms "
+              f"{ported * 1e3:>12,.3f}ms {worse:>8}")
+    worse = [c for c in comparisons if c.worst > min_loss]
+    varies = [c for c in comparisons if c.key_varies]
+    print(f"\n{len(comparisons)} 个用例 x {len(profiles)} 个 profile, {len(worse)} 个用例沿用原 SoC 的 tiling "
+          f"在其他 profile 上慢 {min_loss:.0%} 以上"
+          + (f", {len(varies)} 个用例的 tiling key 随 SoC 变化" if any(r.tiling_key is not None
+                                                                 for c in comparisons for r in c.results) else ""))
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="跨 SoC 的 tiling 决策比较")
+    add_model_args(parser)
+    parser.add_argument("--profiles", default="all",
+                        help="逗号分隔的硬件 profile 名 (registry/hardware_profiles.yaml，默认 all)")
+    parser.add_argument("--min-loss", type=float, default=DEFAULT_MIN_LOSS,
+                        help=f"沿用原 SoC 的 tiling 慢出该比例时标记 (默认 {DEFAULT_MIN_LOSS})")
+    parser.add_argument("--top", type=int, help="只列出损失最大的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例、逐 profile 的结果写入 JSON 文件")
+    args = parser.parse_args()
+
+    try:
+        profiles = select_profiles(args.profiles)
+        comparisons = compare_corpus(profiles, source_from_args(args), parse_hw_overrides(args.hw), args.op)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    comparisons.sort(key=lambda c: (c.worst, c.key_varies), reverse=True)
+    print_report(comparisons, args.min_loss, args.top)
+    print_summary(comparisons, profiles, args.min_loss)
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(c, args.min_loss) for c in comparisons], f, ensure_ascii=False, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+两个 ops-transformer 版本的 tiling A/B 比较
+
+同一份生成用例分别在两个 ops-transformer 检出上编译运行 (见 runner/tiling_ab.sh)，每一侧的结果目录包含
+UTGEN_TILING_RECORD 写出的 tiling.store 与 UTGEN_REPORT_DIR 写出的 tiling_latency.json。逐用例比较:
+  - tiling key / block dim / workspace / tiling data 长度: 取自两侧的快照存储
+  - tiling data 字段: 两侧各自按本侧 ops-transformer 的 op_tiling 头文件解码 (结构体本身可能随版本变化)，
+      列出取值不同或只在一侧存在的字段
+  - tiling 耗时: 两侧 tiling_latency.json 中该用例样本的中位数，B/A 超出 --latency-threshold (默认 10%) 时标记
+  - 估算 kernel 耗时: 两侧的 tiling 决策各自代入代价模型 (同 soc_compare.py 的估算: cube 用例取 tiling_tuner.py 的打分，
+      其余用例取通信带宽下限与向量搬运时间的较大者)，B 比 A 慢出 --min-impact (默认 5%) 以上时标记
+只列出有差异的用例；向量 / 纯通信用例的代价模型不依赖 tiling data，估算耗时只对 cube 用例有区分度。
+结果目录也可以直接给出快照存储文件，此时不比较 tiling 耗时。
+结果目录中的 ut_status (tiling_ab.sh 写出的 gtest 退出码) 非零时在报告开头提示，该侧可能有用例未记录；--strict 下同样返回非零。
+
+用法:
+  ./runner/tiling_ab.sh /workspace/ops-transformer-old /workspace/ops-transformer-new
+  python3 utils/tiling_ab_diff.py ab/old ab/new --ops-transformer-a /workspace/ops-transformer-old \\
+      --ops-transformer-b /workspace/ops-transformer-new
+  python3 utils/tiling_ab_diff.py base.store new.store --op matmul_all_reduce --json ab.json --strict
+"""
+
+import argparse
+import json
+import statistics
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+from case_corpus import load_corpus, mock_rank_nums, probe_op_names
+from case_model import (CaseModel, TilingSource, build_model, expected_failure, fmt_bytes, fmt_us,
+                        parse_hw_overrides, short_id)
+from perf_gate import load_samples
+from soc_compare import estimate_time
+
+DEFAULT_MIN_IMPACT = 0.05
+DEFAULT_LATENCY_THRESHOLD = 0.10
+STORE_NAME = "tiling.store"
+LATENCY_NAME = "tiling_latency.json"
+STATUS_NAME = "ut_status"
+MAX_FIELDS_SHOWN = 8
+
+
+@dataclass
+class Side:
+    label: str
+    source: TilingSource
+    latency: Dict[str, float]     # 用例名 -> tiling 耗时中位数 (ns)
+    ut_status: Optional[int]      # gtest 退出码，没有记录时为 None
+
+
+def load_side(path: Path, label: Optional[str], ops_transformer: Optional[str], includes: List[str]) -> Side:
+    store = path / STORE_NAME if path.is_dir() else path
+    if not store.is_file():
+        raise ValueError(f"没有找到快照存储: {store}")
+    latency = {}
+    if path.is_dir() and (path / LATENCY_NAME).is_file():
+        samples = load_samples(path / LATENCY_NAME)
+        latency = {f"{op}/{case}": statistics.median(ns) for (op, case), ns in samples.items() if ns}
+    ut_status = None
+    if path.is_dir() and (path / STATUS_NAME).is_file():
+        text = (path / STATUS_NAME).read_text().strip()
+        if not text.isdigit():
+            raise ValueError(f"无法解析 gtest 退出码: {path / STATUS_NAME}")
+        ut_status = int(text)
+    return Side(label or path.name, TilingSource(store, ops_transformer, includes), latency, ut_status)
+
+
+@dataclass
+class CaseDiff:
+    a: CaseModel
+    b: CaseModel
+    entry_a: dict
+    entry_b: dict
+    fields: List[Tuple[str, object, object]] = field(default_factory=list)
+    latency_a: Optional[float] = None
+    latency_b: Optional[float] = None
+    time_a: float = 0.0
+    time_b: float = 0.0
+
+    @property
+    def changes(self) -> List[str]:
+        changed = [name for name in ("tilingKey", "blockDim", "workspaces")
+                   if self.entry_a[name] != self.entry_b[name]]
+        if len(self.entry_a["data"]) != len(self.entry_b["data"]):
+            changed.append("dataSize")
+        if self.fields or (self.entry_a["data"] != self.entry_b["data"] and "dataSize" not in changed):
+            changed.append("data")
+        return changed
+
+    @property
+    def latency_ratio(self) -> Optional[float]:
+        if self.latency_a and self.latency_b:
+            return self.latency_b / self.latency_a
+        return None
+
+    @property
+    def impact(self) -> float:
+        return self.time_b / self.time_a - 1 if self.time_a else 0.0
+
+
+def field_diff(a: Optional[List[Tuple[str, object]]], b: Optional[List[Tuple[str, object]]]) \
+        -> List[Tuple[str, object, object]]:
+    if a is None or b is None:
+        return []
+    old, new = dict(a), dict(b)
+    paths = [p for p, _ in a] + [p for p, _ in b if p not in old]
+    return [(p, old.get(p), new.get(p)) for p in paths if old.get(p) != new.get(p)]
+
+
+def diff_case(stem: str, op: str, case: dict, world: int, a: Side, b: Side,
+              overrides: Dict[str, float]) -> Optional[CaseDiff]:
+    model_a = build_model(stem, op, case, world, a.source, overrides)
+    model_b = build_model(stem, op, case, world, b.source, overrides)
+    case_id = model_a.case_id
+    entry_a, entry_b = a.source.store.get(case_id), b.source.store.get(case_id)
+    if entry_a is None or entry_b is None:
+        return None
+    d = CaseDiff(model_a, model_b, entry_a, entry_b)
+    if entry_a["data"] != entry_b["data"]:
+        d.fields = field_diff(a.source.decoded(op, case_id), b.source.decoded(op, case_id))
+    d.latency_a, d.latency_b = a.latency.get(case_id), b.latency.get(case_id)
+    d.time_a, d.time_b = estimate_time(model_a), estimate_time(model_b)
+    return d
+
+
+def diff_corpus(a: Side, b: Side, overrides: Dict[str, float], ops: List[str]) -> Tuple[List[CaseDiff], int]:
+    """返回两侧都有记录的用例的比较结果，以及只在一侧有记录的语料用例数"""
+    op_names, ranks = probe_op_names(), mock_rank_nums()
+    diffs, missing = [], 0
+    for stem, cases in load_corpus().items():
+        op = op_names.get(stem, stem)
+        if ops and stem not in ops and op not in ops:
+            continue
+        for case in cases:
+            if expected_failure(case):
+                continue
+            d = diff_case(stem, op, case, ranks.get(stem) or 8, a, b, overrides)
+            if d is None:
+                missing += 1
+            else:
+                diffs.append(d)
+    return diffs, missing
+
+
+def is_slower(d: CaseDiff, min_impact: float, latency_threshold: float) -> bool:
+    ratio = d.latency_ratio
+    return d.impact > min_impact or (ratio is not None and ratio > 1 + latency_threshold)
+
+
+def fmt_change(old, new) -> str:
+    return str(old) if old == new else f"{old}->{new}"
+
+
+def fmt_ns(ns: Optional[float]) -> str:
+    return "-" if ns is None else fmt_us(ns / 1e9)
+
+
+def to_json(d: CaseDiff, min_impact: float, latency_threshold: float) -> dict:
+    return {
+        "case": d.a.case_id, "changes": d.changes,
+        "tilingKey": [d.entry_a["tilingKey"], d.entry_b["tilingKey"]],
+        "blockDim": [d.entry_a["blockDim"], d.entry_b["blockDim"]],
+        "workspaces": [d.entry_a["workspaces"], d.entry_b["workspaces"]],
+        "tilingDataSize": [len(d.entry_a["data"]), len(d.entry_b["data"])],
+        "fields": [{"path": p, "a": old, "b": new} for p, old, new in d.fields],
+        "latencyNs": [d.latency_a, d.latency_b],
+        "latencyRatio": round(d.latency_ratio, 3) if d.latency_ratio is not None else None,
+        "tilingSource": [t.tiling.source if t.tiling else None for t in (d.a, d.b)],
+        "estimatedUs": [round(d.time_a * 1e6, 3), round(d.time_b * 1e6, 3)],
+        "impact": round(d.impact, 3), "slower": is_slower(d, min_impact, latency_threshold),
+    }
+
+
+def print_report(diffs: List[CaseDiff], a: Side, b: Side, min_impact: float, latency_threshold: float,
+                 top: Optional[int]) -> None:
+    print(f"A = {a.label}, B = {b.label}")
+    for name, side in (("A", a), ("B", b)):
+        if side.ut_status:
+            print(f"⚠️ {name} 侧 gtest 退出码 {side.ut_status}: 有用例断言失败或中途退出，该侧的记录可能不完整")
+    print()
+    print(f"{'用例':<56} {'tiling key':>22} {'block':>7} {'workspace':>19} {'tiling 耗时':>15} "
+          f"{'估算':>21} {'影响':>6}")
+    shown = diffs[:top] if top else diffs
+    for d in shown:
+        mark = "⚠️ " if is_slower(d, min_impact, latency_threshold) else "✅ " if d.impact < -min_impact else "   "
+        ws_a, ws_b = sum(d.entry_a["workspaces"]), sum(d.entry_b["workspaces"])
+        estimate = fmt_change(fmt_us(d.time_a), fmt_us(d.time_b))
+        latency = fmt_change(fmt_ns(d.latency_a), fmt_ns(d.latency_b))
+        print(f"{mark}{short_id(d.a.case_id, 53):<53} "
+              f"{fmt_change(d.entry_a['tilingKey'], d.entry_b['tilingKey']):>22} "
+              f"{fmt_change(d.entry_a['blockDim'], d.entry_b['blockDim']):>7} "
+              f"{fmt_change(fmt_bytes(ws_a), fmt_bytes(ws_b)):>19} {latency:>15} {estimate:>21} {d.impact:>6.0%}")
+        for path, old, new in d.fields[:MAX_FIELDS_SHOWN]:
+            print(f"      {path:<48} {'-' if old is None else old} -> {'-' if new is None else new}")
+        if len(d.fields) > MAX_FIELDS_SHOWN:
+            print(f"      ... 另有 {len(d.fields) - MAX_FIELDS_SHOWN} 个字段不同")
+        elif not d.fields and "data" in d.changes:
+            print(f"      tiling data 不同 ({len(d.entry_a['data'])} -> {len(d.entry_b['data'])} 字节)，未能解码字段")
+    if top and len(diffs) > top:
+        print(f"   ... 另有 {len(diffs) - top} 个用例未列出")
+
+
+def print_summary(diffs: List[CaseDiff], compared: int, missing: int, min_impact: float,
+                  latency_threshold: float) -> None:
+    counts = {name: sum(1 for d in diffs if name in d.changes)
+              for name in ("tilingKey", "blockDim", "workspaces", "dataSize", "data")}
+    print(f"\n{compared} 个用例两侧都有记录" + (f", {missing} 个用例只在一侧或都没有记录" if missing else "")
+          + f"; 有差异的 {len(diffs)} 个: tiling key {counts['tilingKey']}, block dim {counts['blockDim']}, "
+            f"workspace {counts['workspaces']}, tiling data 长度 {counts['dataSize']}, tiling data {counts['data']}")
+    slower_tiling = [d for d in diffs if d.latency_ratio is not None and d.latency_ratio > 1 + latency_threshold]
+    faster_tiling = [d for d in diffs if d.latency_ratio is not None and d.latency_ratio < 1 - latency_threshold]
+    if any(d.latency_ratio is not None for d in diffs):
+        print(f"tiling 耗时: {len(slower_tiling)} 个用例变慢 {latency_threshold:.0%} 以上, "
+              f"{len(faster_tiling)} 个用例变快 {latency_threshold:.0%} 以上")
+    total_a, total_b = sum(d.time_a for d in diffs), sum(d.time_b for d in diffs)
+    slower = [d for d in diffs if d.impact > min_impact]
+    faster = [d for d in diffs if d.impact < -min_impact]
+    print(f"估算 kernel 耗时 (按代价模型): 合计 {total_a * 1e3:,.3f}ms -> {total_b * 1e3:,.3f}ms"
+          + (f" ({total_b / total_a - 1:+.1%})" if total_a else "")
+          + f", {len(slower)} 个用例慢 {min_impact:.0%} 以上, {len(faster)} 个用例快 {min_impact:.0%} 以上")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="两个 ops-transformer 版本的 tiling A/B 比较")
+    parser.add_argument("a", type=Path, help="A 侧结果目录 (含 tiling.store / tiling_latency.json) 或快照存储文件")
+    parser.add_argument("b", type=Path, help="B 侧结果目录或快照存储文件")
+    parser.add_argument("--label-a", help="A 侧名称 (默认取路径名)")
+    parser.add_argument("--label-b", help="B 侧名称 (默认取路径名)")
+    parser.add_argument("--ops-transformer-a", help="A 侧 ops-transformer 路径，用于解码 A 侧的 tiling data")
+    parser.add_argument("--ops-transformer-b", help="B 侧 ops-transformer 路径，用于解码 B 侧的 tiling data")
+    parser.add_argument("--include", action="append", default=[],
+                        help="两侧共用的额外 tiling 结构体头文件或目录，可多次指定")
+    parser.add_argument("--op", action="append", default=[],
+                        help="只比较指定算子 (JSONL 文件名或探针算子名)，可多次指定")
+    parser.add_argument("--hw", action="append", default=[], metavar="KEY=VALUE",
+                        help="覆盖代价模型的硬件参数，如 --hw hbm_gbps=1800")
+    parser.add_argument("--min-impact", type=float, default=DEFAULT_MIN_IMPACT,
+                        help=f"估算 kernel 耗时变化超过该比例时标记 (默认 {DEFAULT_MIN_IMPACT})")
+    parser.add_argument("--latency-threshold", type=float, default=DEFAULT_LATENCY_THRESHOLD,
+                        help=f"tiling 耗时中位数变化超过该比例时标记 (默认 {DEFAULT_LATENCY_THRESHOLD})")
+    parser.add_argument("--top", type=int, help="只列出影响最大的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例的比较结果写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在变慢的用例 (估算耗时或 tiling 耗时) 时返回非零")
+    args = parser.parse_args()
+
+    try:
+        a = load_side(args.a, args.label_a, args.ops_transformer_a, args.include)
+        b = load_side(args.b, args.label_b, args.ops_transformer_b, args.include)
+        results, missing = diff_corpus(a, b, parse_hw_overrides(args.hw), args.op)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    diffs = [d for d in results if d.changes or (d.latency_ratio is not None
+                                                  and abs(d.latency_ratio - 1) > args.latency_threshold)]
+    diffs.sort(key=lambda d: (abs(d.impact), len(d.changes)), reverse=True)
+    print_report(diffs, a, b, args.min_impact, args.latency_threshold, args.top)
+    print_summary(diffs, len(results), missing, args.min_impact, args.latency_threshold)
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump({"sides": {name: {"label": side.label, "gtestStatus": side.ut_status}
+                                 for name, side in (("a", a), ("b", b))},
+                       "cases": [to_json(d, args.min_impact, args.latency_threshold) for d in diffs]}, f,
+                      ensure_ascii=False, indent=2)
+    slower = [d for d in diffs if is_slower(d, args.min_impact, args.latency_threshold)]
+    failed = any(side.ut_status for side in (a, b))
+    sys.exit(1 if args.strict and (slower or failed) else 0)
+
+
+if __name__ == "__main__":
+    main()
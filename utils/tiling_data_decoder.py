@@ -0,0 +1,354 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling data 解码器
+
+从 ops-transformer 的 op_tiling/*.h 中解析 TilingData 结构体定义，把采集到的 tiling data
+(utils/tiling_store.py 读取的快照存储，或十六进制字符串) 渲染为带字段名的取值，
+便于阅读与比较 tiling 的决策 (tile M/N/K、循环次数、通信分块、核数等)。
+
+支持的定义形式:
+  - BEGIN_TILING_DATA_DEF(Name) / TILING_DATA_FIELD_DEF(type, name) /
+    TILING_DATA_FIELD_DEF_ARR(type, N, name) / TILING_DATA_FIELD_DEF_STRUCT(Type, name) / END_TILING_DATA_DEF
+  - 普通 C++ struct / class 的数据成员 (含嵌套结构体与定长数组)
+  - REGISTER_TILING_DATA_CLASS(Op, Name) 给出算子到结构体的映射，未注册时可用 --struct 指定
+字段按声明顺序、自然对齐排布。解析结果按头文件路径、修改时间与大小缓存，头文件未变化时不再重复解析。
+
+用法:
+  python3 utils/tiling_data_decoder.py layouts --struct MatmulAllReduceAddRmsNormTilingData
+  python3 utils/tiling_data_decoder.py decode --store tiling.store --case "MatmulAllReduceAddRmsNorm/xxx"
+  python3 utils/tiling_data_decoder.py decode --struct Mc2BarrierTilingData --hex "0100000020000000"
+  python3 utils/tiling_data_decoder.py diff base.store new.store
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from tiling_store import read_store  # noqa: E402
+
+DEFAULT_OPS_TRANSFORMER = os.environ.get("OPS_TRANSFORMER_DIR", "/workspace/ops-transformer-dev")
+DEFAULT_CACHE = Path(__file__).resolve().parent.parent / ".tiling_layout_cache.json"
+CACHE_VERSION = 1
+
+# C 类型 -> struct 格式字符 (小端)
+SCALAR_TYPES = {
+    "bool": "?", "char": "b", "int8_t": "b", "uint8_t": "B",
+    "int16_t": "h", "uint16_t": "H", "short": "h",
+    "int32_t": "i", "uint32_t": "I", "int": "i", "unsigned": "I", "unsigned int": "I",
+    "int64_t": "q", "uint64_t": "Q", "long": "q", "unsigned long": "Q", "size_t": "Q",
+    "float": "f", "double": "d",
+}
+
+MACRO_STRUCT_RE = re.compile(r"BEGIN_TILING_DATA_DEF\s*\(\s*(\w+)\s*\)(.*?)END_TILING_DATA_DEF", re.S)
+MACRO_FIELD_RE = re.compile(
+    r"TILING_DATA_FIELD_DEF(?:_(ARR|STRUCT))?\s*\(\s*([\w:\s]+?)\s*,\s*(?:(\w+)\s*,\s*)?(\w+)\s*\)")
+REGISTER_RE = re.compile(r"REGISTER_TILING_DATA_CLASS\s*\(\s*(\w+)\s*,\s*(\w+)\s*\)")
+CSTRUCT_RE = re.compile(r"\b(?:struct|class)\s+(?:alignas\s*\(\s*\d+\s*\)\s*)?(\w+)\s*(?::[^{;]*)?\{")
+CONST_RE = re.compile(r"(?:#define\s+(\w+)\s+\(?(\d+)U?L*\)?|constexpr\s+[\w:]+\s+(\w+)\s*=\s*(\d+)U?L*\s*;)")
+CMEMBER_RE = re.compile(
+    r"^(?:const\s+)?([A-Za-z_][\w:]*(?:\s+(?:int|long))?)\s+(\w+)\s*((?:\[\s*\w+\s*\])*)\s*(?:=[^;]*|\{[^;]*\})?$")
+
+
+def strip_comments(text: str) -> str:
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def matching_brace(text: str, open_index: int) -> int:
+    depth = 0
+    for i in range(open_index, len(text)):
+        if text[i] == "{":
+            depth += 1
+        elif text[i] == "}":
+            depth -= 1
+            if depth == 0:
+                return i
+    return -1
+
+
+def parse_c_struct_body(body: str) -> Optional[List[dict]]:
+    """解析 struct 体中的数据成员；包含无法识别的成员声明时返回 None"""
+    # 去掉成员函数体与访问控制
+    while True:
+        match = re.search(r"\)\s*(?:const\s*)?(?:noexcept\s*)?(?:override\s*)?\{", body)
+        if not match:
+            break
+        end = matching_brace(body, match.end() - 1)
+        if end < 0:
+            return None
+        body = body[:match.end() - 1] + ";" + body[end + 1:]
+    body = re.sub(r"\b(?:public|private|protected)\s*:", "", body)
+    fields = []
+    for statement in body.split(";"):
+        statement = " ".join(statement.split())
+        if not statement or "(" in statement or statement.startswith(("static ", "using ", "typedef ", "friend ")):
+            continue
+        match = CMEMBER_RE.match(statement)
+        if not match:
+            return None
+        dims = re.findall(r"\[\s*(\w+)\s*\]", match.group(3))
+        fields.append({"type": match.group(1), "name": match.group(2), "dims": dims})
+    return fields
+
+
+def parse_header(text: str) -> dict:
+    """返回 {"structs": {name: [field]}, "registrations": {op: name}, "constants": {name: value}}"""
+    text = strip_comments(text)
+    structs: Dict[str, List[dict]] = {}
+    for match in MACRO_STRUCT_RE.finditer(text):
+        fields = []
+        for kind, ftype, dim, name in MACRO_FIELD_RE.findall(match.group(2)):
+            fields.append({"type": " ".join(ftype.split()), "name": name, "dims": [dim] if kind == "ARR" else []})
+        structs[match.group(1)] = fields
+    for match in CSTRUCT_RE.finditer(text):
+        name = match.group(1)
+        if name in structs:
+            continue
+        end = matching_brace(text, match.end() - 1)
+        if end < 0:
+            continue
+        fields = parse_c_struct_body(text[match.end():end])
+        if fields:
+            structs[name] = fields
+    registrations = {op: name for op, name in REGISTER_RE.findall(text)}
+    constants = {}
+    for define_name, define_value, const_name, const_value in CONST_RE.findall(text):
+        constants[define_name or const_name] = int(define_value or const_value)
+    return {"structs": structs, "registrations": registrations, "constants": constants}
+
+
+class LayoutRegistry:
+    """所有头文件中结构体定义的汇总，带按文件缓存"""
+
+    def __init__(self, headers: List[Path], cache_path: Optional[Path]):
+        self.structs: Dict[str, List[dict]] = {}
+        self.registrations: Dict[str, str] = {}
+        self.constants: Dict[str, int] = {}
+        cache = self._load_cache(cache_path)
+        fresh = {}
+        for header in headers:
+            stat = header.stat()
+            key = str(header.resolve())
+            entry = cache.get(key)
+            if entry is None or entry["mtime"] != stat.st_mtime_ns or entry["size"] != stat.st_size:
+                parsed = parse_header(header.read_text(encoding="utf-8", errors="ignore"))
+                entry = {"mtime": stat.st_mtime_ns, "size": stat.st_size, "parsed": parsed}
+            fresh[key] = entry
+            self.structs.update(entry["parsed"]["structs"])
+            self.registrations.update(entry["parsed"]["registrations"])
+            self.constants.update(entry["parsed"]["constants"])
+        if cache_path is not None and fresh != cache:
+            cache_path.write_text(json.dumps({"version": CACHE_VERSION, "files": fresh}), encoding="utf-8")
+        self._layouts: Dict[str, Tuple[int, int, List[dict]]] = {}
+
+    @staticmethod
+    def _load_cache(cache_path: Optional[Path]) -> dict:
+        if cache_path is None or not cache_path.exists():
+            return {}
+        try:
+            data = json.loads(cache_path.read_text(encoding="utf-8"))
+        except ValueError:
+            return {}
+        return data.get("files", {}) if data.get("version") == CACHE_VERSION else {}
+
+    def struct_for_op(self, op: str) -> Optional[str]:
+        """算子名 -> 结构体名：优先 REGISTER_TILING_DATA_CLASS，其次 <Op>TilingData"""
+        if op in self.registrations:
+            return self.registrations[op]
+        candidates = [f"{op}TilingData", f"Mc2{op}TilingData"]
+        return next((name for name in candidates if name in self.structs), None)
+
+    def _dim(self, dim: str) -> int:
+        if dim.isdigit():
+            return int(dim)
+        if dim in self.constants:
+            return self.constants[dim]
+        raise ValueError(f"无法解析数组长度 {dim}")
+
+    def layout(self, name: str) -> Tuple[int, int, List[dict]]:
+        """返回 (size, align, fields)，fields 为 {name, offset, fmt|struct, count}"""
+        if name in self._layouts:
+            return self._layouts[name]
+        base = name.split("::")[-1]
+        if base not in self.structs:
+            raise ValueError(f"找不到结构体 {name} 的定义，可用 --include 指定其所在目录")
+        offset, max_align, fields = 0, 1, []
+        for field in self.structs[base]:
+            count = 1
+            for dim in field["dims"]:
+                count *= self._dim(dim)
+            ftype = " ".join(field["type"].replace("std::", "").split())
+            if ftype in SCALAR_TYPES:
+                fmt = SCALAR_TYPES[ftype]
+                size = align = struct.calcsize("<" + fmt)
+                entry = {"name": field["name"], "fmt": fmt}
+            else:
+                size, align, _ = self.layout(ftype)
+                entry = {"name": field["name"], "struct": ftype.split("::")[-1]}
+            offset = (offset + align - 1) // align * align
+            entry.update({"offset": offset, "count": count, "size": size})
+            fields.append(entry)
+            offset += size * count
+            max_align = max(max_align, align)
+        total = (offset + max_align - 1) // max_align * max_align
+        self._layouts[name] = (total, max_align, fields)
+        return self._layouts[name]
+
+    def decode(self, name: str, data: bytes, base: int = 0, prefix: str = "") -> List[Tuple[str, object]]:
+        """把 data[base:] 按结构体 name 解码为 (字段路径, 值) 列表；超出数据长度的字段值为 None"""
+        _, _, fields = self.layout(name)
+        values = []
+        for field in fields:
+            for index in range(field["count"]):
+                path = prefix + field["name"] + (f"[{index}]" if field["count"] > 1 else "")
+                offset = base + field["offset"] + index * field["size"]
+                if "struct" in field:
+                    values.extend(self.decode(field["struct"], data, offset, path + "."))
+                elif offset + field["size"] <= len(data):
+                    values.append((path, struct.unpack_from("<" + field["fmt"], data, offset)[0]))
+                else:
+                    values.append((path, None))
+        return values
+
+
+def find_headers(ops_transformer: Path, includes: List[Path]) -> List[Path]:
+    """ops-transformer 下所有 op_tiling 目录中的头文件，加上 --include 指定的文件或目录"""
+    headers = sorted((ops_transformer / "mc2").glob("**/op_tiling/**/*.h"))
+    for include in includes:
+        headers.extend([include] if include.is_file() else sorted(include.rglob("*.h")))
+    return headers
+
+
+def build_registry(args) -> LayoutRegistry:
+    headers = find_headers(Path(args.ops_transformer), [Path(p) for p in args.include])
+    if not headers:
+        raise ValueError(f"没有找到 op_tiling 头文件: {args.ops_transformer}/mc2")
+    return LayoutRegistry(headers, None if args.no_cache else args.cache)
+
+
+def resolve_struct(registry: LayoutRegistry, case_id: str, explicit: Optional[str]) -> str:
+    if explicit:
+        return explicit
+    op = case_id.split("/", 1)[0]
+    name = registry.struct_for_op(op)
+    if name is None:
+        raise ValueError(f"算子 {op} 没有注册 TilingData 结构体，请用 --struct 指定")
+    return name
+
+
+def format_value(value) -> str:
+    if value is None:
+        return "<超出 tiling data 长度>"
+    if isinstance(value, float):
+        return f"{value:g}"
+    return str(value)
+
+
+def print_decoded(name: str, registry: LayoutRegistry, data: bytes) -> None:
+    size, _, _ = registry.layout(name)
+    print(f"{name} ({size} 字节, 实际 tiling data {len(data)} 字节)")
+    for path, value in registry.decode(name, data):
+        print(f"  {path:<48} {format_value(value)}")
+
+
+def cmd_layouts(args) -> int:
+    registry = build_registry(args)
+    if not args.struct:
+        for op, name in sorted(registry.registrations.items()):
+            print(f"{op:<48} {name}")
+        print(f"\n{len(registry.structs)} 个结构体, {len(registry.registrations)} 个算子注册")
+        return 0
+    size, align, fields = registry.layout(args.struct)
+    print(f"{args.struct}: {size} 字节, 对齐 {align}")
+    for field in fields:
+        kind = field.get("struct") or field["fmt"]
+        count = f"[{field['count']}]" if field["count"] > 1 else ""
+        print(f"  +{field['offset']:<6} {kind:<24} {field['name']}{count}")
+    return 0
+
+
+def cmd_decode(args) -> int:
+    registry = build_registry(args)
+    if args.hex:
+        if not args.struct:
+            raise ValueError("--hex 需要同时指定 --struct")
+        print_decoded(args.struct, registry, bytes.fromhex(args.hex.replace(" ", "")))
+        return 0
+    if not args.store:
+        raise ValueError("需要 --store 或 --hex")
+    store = read_store(args.store)
+    cases = [args.case] if args.case else sorted(store)
+    for case_id in cases:
+        if case_id not in store:
+            raise ValueError(f"存储中没有用例 {case_id}")
+        entry = store[case_id]
+        print(f"== {case_id}  tilingKey={entry['tilingKey']} blockDim={entry['blockDim']}")
+        print_decoded(resolve_struct(registry, case_id, args.struct), registry, entry["data"])
+    return 0
+
+
+def cmd_diff(args) -> int:
+    registry = build_registry(args)
+    base, new = read_store(args.base), read_store(args.new)
+    cases = [args.case] if args.case else sorted(set(base) & set(new))
+    changed = 0
+    for case_id in cases:
+        if base[case_id]["data"] == new[case_id]["data"]:
+            continue
+        name = resolve_struct(registry, case_id, args.struct)
+        old_values = dict(registry.decode(name, base[case_id]["data"]))
+        new_values = registry.decode(name, new[case_id]["data"])
+        changed += 1
+        print(f"❌ {case_id} ({name})")
+        for path, value in new_values:
+            if old_values.get(path) != value:
+                print(f"     {path:<48} {format_value(old_values.get(path))} -> {format_value(value)}")
+    print(f"\n{changed} 个用例的 tiling data 不同" if changed else "\n✅ tiling data 完全一致")
+    return 1 if changed else 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="按 op_tiling 头文件中的结构体定义解码 tiling data")
+    parser.add_argument("--ops-transformer", default=DEFAULT_OPS_TRANSFORMER,
+                        help="ops-transformer 仓库路径 (默认取 OPS_TRANSFORMER_DIR 环境变量)")
+    parser.add_argument("--include", action="append", default=[],
+                        help="额外的头文件或目录 (如 TCubeTiling 所在的 kernel_tiling)，可多次指定")
+    parser.add_argument("--cache", type=Path, default=DEFAULT_CACHE, help="结构体解析缓存文件")
+    parser.add_argument("--no-cache", action="store_true", help="不读写解析缓存")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p_layouts = sub.add_parser("layouts", help="列出算子注册，或打印一个结构体的字段布局")
+    p_layouts.add_argument("--struct", help="结构体名")
+    p_layouts.set_defaults(func=cmd_layouts)
+
+    p_decode = sub.add_parser("decode", help="解码快照存储中的用例或十六进制 tiling data")
+    p_decode.add_argument("--store", type=Path, help="utils/tiling_store.py 读取的快照存储")
+    p_decode.add_argument("--case", help='用例名 "<op>/<case>"，不指定时解码全部用例')
+    p_decode.add_argument("--hex", help="十六进制 tiling data")
+    p_decode.add_argument("--struct", help="结构体名，不指定时按算子注册查找")
+    p_decode.set_defaults(func=cmd_decode)
+
+    p_diff = sub.add_parser("diff", help="按字段比较两个快照存储中的 tiling data")
+    p_diff.add_argument("base", type=Path)
+    p_diff.add_argument("new", type=Path)
+    p_diff.add_argument("--case", help="只比较一个用例")
+    p_diff.add_argument("--struct", help="结构体名，不指定时按算子注册查找")
+    p_diff.set_defaults(func=cmd_diff)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (ValueError, KeyError, OSError, struct.error) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
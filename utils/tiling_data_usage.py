@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling data 利用率报告
+
+用例构造 TilingContextPara 时会预留 tilingDataSize 字节 (4096 / 8192 / 40960 等)，
+tiling data 在每次 kernel 下发时都要从 host 拷贝到 device。本工具读取生成用例写出的
+tiling_results.json (见 utgen_tiling_capture.h)，统计实际写入的字节数:
+  - 每个用例: 已用字节 / 预留字节 / 利用率
+  - 每个 (算子, tiling key): 已用字节的高水位
+  - 每个算子: 高水位、预留上限与建议的预留长度
+并标出两类问题:
+  - 预留过大: 算子高水位低于预留的 --oversized 比例 (默认 25%)
+  - 接近溢出: 用例已用字节达到预留的 --near-overflow 比例 (默认 90%)
+
+多份结果文件 (如多次 --gtest_repeat 或多个 UT 可执行文件) 合并统计，同一用例取最大值。
+
+用法:
+  python3 utils/tiling_data_usage.py report/tiling_results.json
+  python3 utils/tiling_data_usage.py report/tiling_results.json --json report/tiling_data_usage.json --strict
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+DEFAULT_OVERSIZED = 0.25
+DEFAULT_NEAR_OVERFLOW = 0.90
+DEFAULT_HEADROOM = 0.25
+DEFAULT_ALIGN = 512
+
+
+def load_usage(paths: List[Path]) -> Dict[Tuple[str, str], dict]:
+    """(op, case) -> {tilingKey, used, capacity}，只统计 tiling 成功且记录了预留长度的用例"""
+    usage: Dict[Tuple[str, str], dict] = {}
+    for path in paths:
+        records = json.loads(path.read_text(encoding="utf-8"))
+        if not isinstance(records, list):
+            raise ValueError(f"{path} 不是 tiling_results.json 格式")
+        for record in records:
+            if not record.get("success") or not record.get("tilingDataCapacity"):
+                continue
+            key = (record["op"], record["case"])
+            entry = usage.setdefault(key, {"tilingKey": record["tilingKey"], "used": 0, "capacity": 0})
+            entry["used"] = max(entry["used"], int(record["tilingDataSize"]))
+            entry["capacity"] = max(entry["capacity"], int(record["tilingDataCapacity"]))
+    return usage
+
+
+def suggest_capacity(high_water: int, headroom: float, align: int) -> int:
+    """在高水位上留出余量并按 align 向上取整"""
+    target = int(high_water * (1 + headroom))
+    return max(align, (target + align - 1) // align * align)
+
+
+def build_report(usage: Dict[Tuple[str, str], dict], oversized: float, near_overflow: float,
+                 headroom: float, align: int) -> List[dict]:
+    ops: Dict[str, dict] = {}
+    for (op, case), entry in sorted(usage.items()):
+        info = ops.setdefault(op, {"op": op, "cases": [], "keys": {}})
+        ratio = entry["used"] / entry["capacity"]
+        info["cases"].append({
+            "case": case, "tilingKey": entry["tilingKey"], "used": entry["used"],
+            "capacity": entry["capacity"], "utilization": round(ratio, 4),
+            "overflowRisk": entry["used"] > entry["capacity"] or ratio >= near_overflow,
+        })
+        key = str(entry["tilingKey"])
+        info["keys"][key] = max(info["keys"].get(key, 0), entry["used"])
+
+    report = []
+    for op, info in ops.items():
+        high_water = max(c["used"] for c in info["cases"])
+        capacity = max(c["capacity"] for c in info["cases"])
+        report.append({
+            "op": op,
+            "highWater": high_water,
+            "capacity": capacity,
+            "utilization": round(high_water / capacity, 4),
+            "oversized": high_water < capacity * oversized,
+            "suggestedCapacity": suggest_capacity(high_water, headroom, align),
+            "keys": dict(sorted(info["keys"].items())),
+            "cases": info["cases"],
+        })
+    return report
+
+
+def print_report(report: List[dict], verbose: bool) -> None:
+    print(f"  {'算子':<30} {'用例':>5} {'高水位':>8} {'预留':>8} {'利用率':>7} {'建议预留':>8}")
+    for op in report:
+        mark = "⚠️" if op["oversized"] or any(c["overflowRisk"] for c in op["cases"]) else "  "
+        print(f"{mark}{op['op']:<30} {len(op['cases']):>5} {op['highWater']:>8} {op['capacity']:>8} "
+              f"{op['utilization']:>7.1%} {op['suggestedCapacity']:>8}")
+        if verbose:
+            for key, used in op["keys"].items():
+                print(f"      tilingKey {key}: 高水位 {used} 字节")
+    for op in report:
+        if op["oversized"]:
+            print(f"⚠️  {op['op']}: 预留过大，高水位 {op['highWater']} / 预留 {op['capacity']} 字节，"
+                  f"建议预留 {op['suggestedCapacity']} 字节")
+        for case in op["cases"]:
+            if case["overflowRisk"]:
+                print(f"❌ {op['op']} / {case['case']}: 已用 {case['used']} / 预留 {case['capacity']} 字节 "
+                      f"({case['utilization']:.1%})，接近溢出")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="tiling data 利用率报告：按用例与 tiling key 统计实际写入的字节数")
+    parser.add_argument("sources", type=Path, nargs="+", help="tiling_results.json (可多个)")
+    parser.add_argument("--oversized", type=float, default=DEFAULT_OVERSIZED,
+                        help=f"高水位低于预留的该比例时判定为预留过大 (默认 {DEFAULT_OVERSIZED})")
+    parser.add_argument("--near-overflow", type=float, default=DEFAULT_NEAR_OVERFLOW,
+                        help=f"已用达到预留的该比例时判定为接近溢出 (默认 {DEFAULT_NEAR_OVERFLOW})")
+    parser.add_argument("--headroom", type=float, default=DEFAULT_HEADROOM,
+                        help=f"建议预留长度在高水位上留出的余量 (默认 {DEFAULT_HEADROOM})")
+    parser.add_argument("--align", type=int, default=DEFAULT_ALIGN,
+                        help=f"建议预留长度的对齐字节数 (默认 {DEFAULT_ALIGN})")
+    parser.add_argument("--json", type=Path, help="把报告写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在接近溢出的用例时返回非零")
+    parser.add_argument("-v", "--verbose", action="store_true", help="列出每个 tiling key 的高水位")
+    args = parser.parse_args()
+
+    try:
+        usage = load_usage(args.sources)
+    except (ValueError, KeyError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    if not usage:
+        print("⚠️  没有记录了预留长度的成功用例")
+        sys.exit(0)
+
+    report = build_report(usage, args.oversized, args.near_overflow, args.headroom, args.align)
+    print_report(report, args.verbose)
+    if args.json:
+        args.json.write_text(json.dumps(report, ensure_ascii=False, indent=2), encoding="utf-8")
+    overflow = any(c["overflowRisk"] for op in report for c in op["cases"])
+    sys.exit(1 if args.strict and overflow else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling key 解码与 kernel 变体覆盖报告
+
+tiling key 是按位段打包的特性选择 (量化模式、转置、bias、通信算法等)，用例只把它当作整数比较。
+本工具按 registry/tiling_keys.yaml 中登记的位段把 key 解码为具名特性，并统计语料覆盖了哪些 kernel 变体:
+  - decode: 解码单个 key
+  - report: 按算子统计每个 key 与每个特性取值命中的用例数，列出登记表中语料未覆盖的取值
+            与未登记的位；key 来源为 input/*.jsonl 中的期望 key，
+            也可以加入 UT 运行时采集的 tiling_results.json (见 utgen_tiling_capture.h)
+
+用法:
+  python3 utils/tiling_key_decoder.py decode MatmulAllReduceAddRmsNorm 365333139620609
+  python3 utils/tiling_key_decoder.py report
+  python3 utils/tiling_key_decoder.py report --results report/tiling_results.json --json key_coverage.json
+"""
+
+import argparse
+import json
+import sys
+from collections import Counter, defaultdict
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+try:
+    import yaml
+except ImportError:
+    print("❌ 缺少依赖 PyYAML (读取 registry/*.yaml 需要)，请先执行: pip install -r requirements.txt")
+    sys.exit(2)
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from case_corpus import ROOT, case_name, expected_tiling_key, load_corpus, probe_op_names  # noqa: E402
+
+DEFAULT_REGISTRY = ROOT / "registry" / "tiling_keys.yaml"
+
+
+def load_registry(path: Path) -> Dict[str, dict]:
+    registry = yaml.safe_load(path.read_text(encoding="utf-8")) or {}
+    for op, layout in registry.items():
+        if layout.get("encoding") not in ("bits", "decimal"):
+            raise ValueError(f"{op}: encoding 只能是 bits 或 decimal")
+    return registry
+
+
+def field_value(layout: dict, field: dict, key: int) -> int:
+    if layout["encoding"] == "bits":
+        return (key >> field["bit"]) & ((1 << field["width"]) - 1)
+    return (key // 10 ** field["digit"]) % 10 ** field["width"]
+
+
+def field_mask(layout: dict, field: dict, key: int) -> int:
+    """key 中该字段所占部分的数值，用于求未登记的剩余部分"""
+    if layout["encoding"] == "bits":
+        return field_value(layout, field, key) << field["bit"]
+    return field_value(layout, field, key) * 10 ** field["digit"]
+
+
+def decode_key(layout: dict, key: int) -> Tuple[List[Tuple[str, int, Optional[str]]], int]:
+    """返回 ([(字段名, 取值, 含义)], 未登记部分)"""
+    features = []
+    rest = key
+    for field in layout["fields"]:
+        value = field_value(layout, field, key)
+        label = (field.get("values") or {}).get(value)
+        features.append((field["name"], value, label))
+        rest -= field_mask(layout, field, key)
+    return features, rest
+
+
+def format_features(features: List[Tuple[str, int, Optional[str]]], rest: int, encoding: str) -> str:
+    parts = [f"{name}={value}" + (f"({label})" if label else "") for name, value, label in features]
+    if rest:
+        parts.append(f"未登记={hex(rest) if encoding == 'bits' else rest}")
+    return ", ".join(parts)
+
+
+def collect_keys(results: List[Path]) -> Dict[str, List[Tuple[str, int, str]]]:
+    """算子名 -> [(用例名, key, 来源)]"""
+    keys: Dict[str, List[Tuple[str, int, str]]] = defaultdict(list)
+    op_names = probe_op_names()
+    for stem, cases in load_corpus().items():
+        op = op_names.get(stem, stem)
+        for case in cases:
+            key = expected_tiling_key(case)
+            if key is not None:
+                keys[op].append((case_name(case), key, "jsonl"))
+    for path in results:
+        for record in json.loads(path.read_text(encoding="utf-8")):
+            if record.get("success"):
+                keys[record["op"]].append((record["case"], int(record["tilingKey"]), "ut"))
+    return keys
+
+
+def build_report(registry: Dict[str, dict], keys: Dict[str, List[Tuple[str, int, str]]]) -> List[dict]:
+    report = []
+    for op in sorted(set(keys) | set(registry)):
+        layout = registry.get(op)
+        entries = keys.get(op, [])
+        key_hist = Counter(key for _, key, _ in entries)
+        item = {"op": op, "registered": layout is not None, "cases": len(entries),
+                "keys": {str(k): n for k, n in key_hist.most_common()}}
+        if layout is not None:
+            features: Dict[str, Counter] = {f["name"]: Counter() for f in layout["fields"]}
+            unregistered = Counter()
+            for _, key, _ in entries:
+                decoded, rest = decode_key(layout, key)
+                for name, value, _ in decoded:
+                    features[name][value] += 1
+                if rest:
+                    unregistered[rest] += 1
+            item["features"] = {name: {str(v): n for v, n in sorted(hist.items())} for name, hist in features.items()}
+            item["untested"] = {
+                f["name"]: [f"{v}({label})" for v, label in (f.get("values") or {}).items() if v not in features[f["name"]]]
+                for f in layout["fields"]
+            }
+            item["untested"] = {name: values for name, values in item["untested"].items() if values}
+            item["unregistered"] = {str(rest): n for rest, n in unregistered.items()}
+        report.append(item)
+    return report
+
+
+def print_report(report: List[dict], registry: Dict[str, dict]) -> None:
+    for item in report:
+        status = "" if item["registered"] else "  (未登记编码)"
+        print(f"== {item['op']}: {item['cases']} 个带期望 key 的用例, {len(item['keys'])} 个不同的 key{status}")
+        layout = registry.get(item["op"])
+        for key, count in item["keys"].items():
+            detail = format_features(*decode_key(layout, int(key)), layout["encoding"]) if layout else ""
+            print(f"   {count:>4} x {key:<22} {detail}")
+        for name, values in item.get("untested", {}).items():
+            print(f"   ⚠️  {name} 未覆盖: {', '.join(values)}")
+        if item.get("unregistered"):
+            print(f"   ℹ️  存在未登记的位: {', '.join(item['unregistered'])}")
+
+
+def cmd_decode(args) -> int:
+    registry = load_registry(args.registry)
+    if args.op not in registry:
+        print(f"❌ {args.op} 没有登记 tiling key 编码")
+        return 1
+    layout = registry[args.op]
+    key = int(args.key, 0)
+    features, rest = decode_key(layout, key)
+    print(f"{args.op} tilingKey {key} (0x{key:X})")
+    for field, (name, value, label) in zip(layout["fields"], features):
+        note = f"  # {field['note']}" if field.get("note") else ""
+        print(f"  {name:<24} {value:<12} {label or ''}{note}")
+    if rest:
+        print(f"  {'未登记':<21} {hex(rest) if layout['encoding'] == 'bits' else rest}")
+    return 0
+
+
+def cmd_report(args) -> int:
+    registry = load_registry(args.registry)
+    report = build_report(registry, collect_keys(args.results))
+    print_report(report, registry)
+    if args.json:
+        args.json.write_text(json.dumps(report, ensure_ascii=False, indent=2), encoding="utf-8")
+    return 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="tiling key 解码与 kernel 变体覆盖报告")
+    parser.add_argument("--registry", type=Path, default=DEFAULT_REGISTRY,
+                        help=f"tiling key 编码登记表 (默认 {DEFAULT_REGISTRY.relative_to(ROOT)})")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p_decode = sub.add_parser("decode", help="解码单个 tiling key")
+    p_decode.add_argument("op", help="算子名，如 MatmulAllReduce")
+    p_decode.add_argument("key", help="tiling key，支持 0x 前缀")
+    p_decode.set_defaults(func=cmd_decode)
+
+    p_report = sub.add_parser("report", help="统计语料覆盖的 kernel 变体")
+    p_report.add_argument("--results", type=Path, action="append", default=[],
+                          help="UT 运行时采集的 tiling_results.json，可多次指定")
+    p_report.add_argument("--json", type=Path, help="把报告写入 JSON 文件")
+    p_report.set_defaults(func=cmd_report)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (ValueError, KeyError, OSError, yaml.YAMLError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tiling 结果快照存储的读取工具
+
+存储由生成用例在 UTGEN_TILING_RECORD=<file> 下写出，格式见 template/include/utgen_tiling_store.h。
+  - list: 列出每个用例的 tiling key、block dim、workspace 与 tiling data 长度
+  - show: 打印一个用例的完整记录与 tiling data 十六进制
+  - diff: 比较两个存储 (如 ops-transformer 修改前后各记录一次)，逐用例列出差异，有差异时返回非零
+
+用法:
+  python3 utils/tiling_store.py list tiling.store
+  python3 utils/tiling_store.py show tiling.store "MatmulAllReduce/big_K"
+  python3 utils/tiling_store.py diff base.store new.store
+"""
+
+import argparse
+import mmap
+import struct
+import sys
+from pathlib import Path
+from typing import Dict
+
+MAGIC = b"UTGS"
+VERSION = 1
+HEADER = struct.Struct("<4sIIIQQ")
+ENTRY = struct.Struct("<QIIQqqII")
+BLOB = struct.Struct("<QQQ")
+
+
+def read_store(path: Path) -> Dict[str, dict]:
+    """用例名 ("<op>/<case>") -> {tilingKey, blockDim, workspaces, data}"""
+    with open(path, "rb") as f, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+        if len(mm) < HEADER.size:
+            raise ValueError(f"{path} 不是 tiling 存储文件")
+        magic, version, entry_count, blob_count, workspace_count, name_bytes = HEADER.unpack_from(mm, 0)
+        if magic != MAGIC or version != VERSION:
+            raise ValueError(f"{path} 不是 tiling 存储文件 (magic {magic!r}, version {version})")
+        entries_offset = HEADER.size
+        blobs_offset = entries_offset + entry_count * ENTRY.size
+        workspaces_offset = blobs_offset + blob_count * BLOB.size
+        names_offset = workspaces_offset + workspace_count * 8
+        if names_offset + name_bytes > len(mm):
+            raise ValueError(f"{path} 已截断")
+
+        blobs = {}
+        for i in range(blob_count):
+            blob_hash, offset, size = BLOB.unpack_from(mm, blobs_offset + i * BLOB.size)
+            blobs[blob_hash] = bytes(mm[offset:offset + size])
+        workspaces = struct.unpack_from(f"<{workspace_count}q", mm, workspaces_offset)
+
+        store = {}
+        for i in range(entry_count):
+            (_, name_offset, name_len, blob_hash, tiling_key, block_dim,
+             ws_offset, ws_count) = ENTRY.unpack_from(mm, entries_offset + i * ENTRY.size)
+            start = names_offset + name_offset
+            name = mm[start:start + name_len].decode("utf-8")
+            store[name] = {
+                "tilingKey": tiling_key,
+                "blockDim": block_dim,
+                "workspaces": list(workspaces[ws_offset:ws_offset + ws_count]),
+                "data": blobs.get(blob_hash, b""),
+            }
+    return store
+
+
+def hexdump(data: bytes, width: int = 16) -> str:
+    lines = []
+    for offset in range(0, len(data), width):
+        chunk = data[offset:offset + width]
+        lines.append(f"  {offset:08x}  {chunk.hex(' '):<{width * 3}}")
+    return "\n".join(lines)
+
+
+def diff_entry(old: dict, new: dict) -> list:
+    diffs = []
+    for field in ("tilingKey", "blockDim", "workspaces"):
+        if old[field] != new[field]:
+            diffs.append(f"{field} {old[field]} -> {new[field]}")
+    old_data, new_data = old["data"], new["data"]
+    if len(old_data) != len(new_data):
+        diffs.append(f"tiling data 长度 {len(old_data)} -> {len(new_data)}")
+    changed = [i for i in range(min(len(old_data), len(new_data))) if old_data[i] != new_data[i]]
+    if changed:
+        diffs.append(f"tiling data {len(changed)} 个字节不同，首个差异位于偏移 {changed[0]}")
+    return diffs
+
+
+def cmd_list(args) -> int:
+    store = read_store(args.store)
+    print(f"{'用例':<72} {'tilingKey':>20} {'blockDim':>8} {'data':>6}  workspaces")
+    for name in sorted(store):
+        entry = store[name]
+        print(f"{name:<72} {entry['tilingKey']:>20} {entry['blockDim']:>8} {len(entry['data']):>6}  "
+              f"{entry['workspaces']}")
+    blobs = len({entry["data"] for entry in store.values()})
+    print(f"\n{len(store)} 个用例, {blobs} 份不同的 tiling data")
+    return 0
+
+
+def cmd_show(args) -> int:
+    store = read_store(args.store)
+    if args.case not in store:
+        print(f"❌ 存储中没有用例 {args.case}")
+        return 1
+    entry = store[args.case]
+    print(f"case:       {args.case}")
+    print(f"tilingKey:  {entry['tilingKey']} (0x{entry['tilingKey'] & 0xFFFFFFFFFFFFFFFF:X})")
+    print(f"blockDim:   {entry['blockDim']}")
+    print(f"workspaces: {entry['workspaces']}")
+    print(f"tiling data ({len(entry['data'])} 字节):")
+    print(hexdump(entry["data"]))
+    return 0
+
+
+def cmd_diff(args) -> int:
+    base, new = read_store(args.base), read_store(args.new)
+    changed = 0
+    for name in sorted(set(base) & set(new)):
+        diffs = diff_entry(base[name], new[name])
+        if diffs:
+            changed += 1
+            print(f"❌ {name}")
+            for d in diffs:
+                print(f"     {d}")
+    only_base, only_new = sorted(set(base) - set(new)), sorted(set(new) - set(base))
+    if only_base:
+        print(f"ℹ️  仅在 {args.base.name} 中: {len(only_base)} 个用例")
+    if only_new:
+        print(f"ℹ️  仅在 {args.new.name} 中: {len(only_new)} 个用例")
+    if changed:
+        print(f"\n❌ {changed} 个用例的 tiling 结果不同")
+        return 1
+    print("\n✅ 共同用例的 tiling 结果完全一致")
+    return 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="tiling 结果快照存储的读取工具")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p_list = sub.add_parser("list", help="列出存储中的用例")
+    p_list.add_argument("store", type=Path)
+    p_list.set_defaults(func=cmd_list)
+
+    p_show = sub.add_parser("show", help="打印一个用例的完整记录")
+    p_show.add_argument("store", type=Path)
+    p_show.add_argument("case", help='用例名，格式为 "<op>/<case>"')
+    p_show.set_defaults(func=cmd_show)
+
+    p_diff = sub.add_parser("diff", help="比较两个存储，有差异时返回非零")
+    p_diff.add_argument("base", type=Path)
+    p_diff.add_argument("new", type=Path)
+    p_diff.set_defaults(func=cmd_diff)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (ValueError, OSError, struct.error) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+基于代价模型的 tiling 搜索
+
+以用例当前的 tiling 决策 (解码的 tiling data 或名义 tile，见 case_model.py) 为中心枚举邻近的合法 tile:
+  - baseM / baseN 取当前值的 1/2、3/4、1、5/4、3/2、2 倍，baseK 取 1/2、1、2 倍，按 16 对齐
+    (int8 / int4 的 baseK 按 32 对齐)，不超过 M / N / K 补齐后的大小
+  - stepM / stepN 取 1、2、4，depthA1 / depthB1 = 2 x stepM / stepN
+  - 只保留 L0A / L0B / L0C / L1 放得下的组合 (见 buffer_footprint.py)
+用代价模型为每个候选打分: 有通信的融合算子取流水耗时 (comm_overlap.py)，其余取 roofline.py 的估算耗时。
+比当前决策快 --min-gain (默认 10%) 以上的用例被列出，并给出候选的 tiling data 字段:
+解码的 tiling 按原字段路径给出改动后的值，名义 tile 按 TCubeTiling 字段名给出。
+名义 tile 并非 tiling 的真实决策，其提升只作参考 (ℹ️)，不计入可提升用例，也不触发 --strict。
+语料中的用例互相独立，用 --jobs 个进程并行搜索。
+
+用法:
+  python3 utils/tiling_tuner.py
+  python3 utils/tiling_tuner.py --op matmul_all_reduce --min-gain 0.2 --jobs 8
+  python3 utils/tiling_tuner.py --store golden/tiling.store --ops-transformer /path/to/ops-transformer --json tuned.json
+"""
+
+import argparse
+import itertools
+import json
+import os
+import re
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import dataclass, replace
+from typing import Dict, List, Optional
+
+from buffer_footprint import analyze as footprint
+from case_model import TILING_ALIASES, CaseModel, Tiling, add_model_args, ceil_div, fmt_us, models_from_args, short_id
+from comm_overlap import estimate
+from roofline import analyze
+
+DEFAULT_MIN_GAIN = 0.10
+MN_SCALES = (0.5, 0.75, 1.0, 1.25, 1.5, 2.0)
+K_SCALES = (0.5, 1.0, 2.0)
+STEPS = (1, 2, 4)
+# Tiling 属性 -> TCubeTiling 字段名，名义 tile 的候选按此输出
+FIELD_NAMES = {"base_m": "baseM", "base_n": "baseN", "base_k": "baseK", "step_m": "stepM", "step_n": "stepN",
+               "depth_a1": "depthA1", "depth_b1": "depthB1"}
+
+
+def score(model: CaseModel) -> float:
+    if model.workload.comm:
+        return estimate(model, None, "fullmesh").total
+    return analyze(model).t_tiling
+
+
+def aligned(value: float, align: int, limit: int) -> int:
+    return max(align, min(ceil_div(int(value), align) * align, ceil_div(limit, align) * align))
+
+
+def candidates(model: CaseModel) -> List[Tiling]:
+    w, t = model.workload, model.tiling
+    k_align = 32 if max(w.a_bytes, w.b_bytes) <= 1 else 16
+    base_ms = sorted({aligned(t.base_m * s, 16, w.m) for s in MN_SCALES})
+    base_ns = sorted({aligned(t.base_n * s, 16, w.n) for s in MN_SCALES})
+    base_ks = sorted({aligned(t.base_k * s, k_align, w.k) for s in K_SCALES})
+    found = []
+    for base_m, base_n, base_k, step_m, step_n in itertools.product(base_ms, base_ns, base_ks, STEPS, STEPS):
+        tiling = replace(t, base_m=base_m, base_n=base_n, base_k=base_k, step_m=step_m, step_n=step_n,
+                         depth_a1=2 * step_m, depth_b1=2 * step_n)
+        if tiling != t and not footprint(replace(model, tiling=tiling)).overflow:
+            found.append(tiling)
+    return found
+
+
+def tiling_data(model: CaseModel, best: Tiling) -> Dict[str, int]:
+    """候选与当前决策不同的字段；解码的 tiling 按原字段路径给出"""
+    t = model.tiling
+    changed = {attr: getattr(best, attr) for attr in FIELD_NAMES if getattr(best, attr) != getattr(t, attr)}
+    if t.source != "decoded":
+        return {FIELD_NAMES[attr]: value for attr, value in changed.items()}
+    data, pending = {}, dict(changed)
+    for path in t.values:
+        leaf = re.sub(r"\[\d+\]$", "", path.rsplit(".", 1)[-1]).lower()
+        for attr in list(pending):
+            if leaf in TILING_ALIASES.get(attr, ()):
+                data[path] = pending.pop(attr)
+    # 解码结构中没有的字段 (如 stepM) 按字段名补充
+    data.update({FIELD_NAMES[attr]: value for attr, value in pending.items()})
+    return data
+
+
+@dataclass
+class Tuned:
+    model: CaseModel
+    current: float
+    best: float
+    tiling: Tiling
+    evaluated: int
+
+    @property
+    def gain(self) -> float:
+        return 1 - self.best / self.current if self.current else 0.0
+
+    @property
+    def nominal(self) -> bool:
+        return self.model.tiling.source != "decoded"
+
+    def over_gain(self, min_gain: float) -> bool:
+        return self.gain > min_gain
+
+    def improvable(self, min_gain: float) -> bool:
+        """名义 tile 没有可供改进的真实决策，提升不标记"""
+        return not self.nominal and self.over_gain(min_gain)
+
+
+def tune(model: CaseModel) -> Tuned:
+    current = score(model)
+    best, best_tiling = current, model.tiling
+    found = candidates(model)
+    for tiling in found:
+        cost = score(replace(model, tiling=tiling))
+        if cost < best:
+            best, best_tiling = cost, tiling
+    return Tuned(model, current, best, best_tiling, len(found))
+
+
+def describe(t: Tiling) -> str:
+    return f"{t.base_m}x{t.base_n}x{t.base_k} step {t.step_m}/{t.step_n}"
+
+
+def to_json(r: Tuned, min_gain: float) -> dict:
+    data = {
+        "case": r.model.case_id, "tilingSource": r.model.tiling.source, "currentUs": round(r.current * 1e6, 3),
+        "bestUs": round(r.best * 1e6, 3), "gain": round(r.gain, 3), "candidates": r.evaluated,
+        "current": describe(r.model.tiling), "best": describe(r.tiling), "estimate": r.nominal,
+        "improvable": r.improvable(min_gain),
+    }
+    if r.tiling is not r.model.tiling:
+        data["tilingData"] = tiling_data(r.model, r.tiling)
+    return data
+
+
+def print_report(results: List[Tuned], min_gain: float, top: Optional[int]) -> None:
+    print(f"{'用例':<64} {'当前 tile':>22} {'候选 tile':>22} {'当前耗时':>10} {'候选耗时':>10} {'提升':>6}")
+    shown = results[:top] if top else results
+    for r in shown:
+        mark = "⚠️ " if r.improvable(min_gain) else "ℹ️ " if r.over_gain(min_gain) else "   "
+        tile = describe(r.model.tiling) + ("*" if r.nominal else "")
+        print(f"{mark}{short_id(r.model.case_id, 61):<61} {tile:>22} {describe(r.tiling):>22} "
+              f"{fmt_us(r.current):>10} {fmt_us(r.best):>10} {r.gain:>6.0%}")
+        if r.over_gain(min_gain):
+            fields = ", ".join(f"{k}={v}" for k, v in tiling_data(r.model, r.tiling).items())
+            print(f"      {fields}")
+    if top and len(results) > top:
+        print(f"   ... 另有 {len(results) - top} 个用例未列出")
+    if any(r.nominal for r in shown):
+        print("\n* 名义 tile: 没有快照存储或无法解码 tiling data 时按 L0 容量推导，提升只反映与典型 tile 的差距 (ℹ️)，不标记")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="基于代价模型的 tiling 搜索")
+    add_model_args(parser)
+    parser.add_argument("--min-gain", type=float, default=DEFAULT_MIN_GAIN,
+                        help=f"候选比当前决策快出该比例时列出 (默认 {DEFAULT_MIN_GAIN})")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="并行搜索的进程数 (默认 CPU 核数)")
+    parser.add_argument("--top", type=int, help="只列出提升最大的前 N 个用例")
+    parser.add_argument("--json", help="把逐用例结果与候选 tiling data 写入 JSON 文件")
+    parser.add_argument("--strict", action="store_true", help="存在可提升的用例 (解码的 tiling) 时返回非零")
+    args = parser.parse_args()
+
+    try:
+        models = models_from_args(args)
+    except (ValueError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+    cube = [m for m in models if m.workload.has_cube]
+    with ProcessPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        results = list(pool.map(tune, cube, chunksize=4))
+    results.sort(key=lambda r: r.gain, reverse=True)
+    print_report(results, args.min_gain, args.top)
+
+    improvable = [r for r in results if r.improvable(args.min_gain)]
+    estimated = [r for r in results if r.nominal and r.over_gain(args.min_gain)]
+    print(f"\n{len(results)} 个用例, 共评估 {sum(r.evaluated for r in results)} 个候选, "
+          f"{len(improvable)} 个用例存在快 {args.min_gain:.0%} 以上的 tiling"
+          + (f", 另有 {len(estimated)} 个名义 tile 用例的估算提升超过 {args.min_gain:.0%} (仅供参考)" if estimated else "")
+          + f" ({args.jobs} 个进程)")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump([to_json(r, args.min_gain) for r in results], f, ensure_ascii=False, indent=2)
+    sys.exit(1 if args.strict and improvable else 0)
+
+
+if __name__ == "__main__":
+    main()
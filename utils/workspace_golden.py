@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+workspace / tiling data 长度的 golden 记录与比对
+
+生成用例在 UTGEN_REPORT_DIR 下写出 tiling_results.json (见 utgen_tiling_capture.h)，
+其中包含每个用例 tiling 实际产出的 workspace 大小与 tiling data 长度。
+  - update: 把本次结果写入 golden 文件 (按算子整体替换，未出现在本次结果中的算子保持不变)
+  - diff:   与 golden 比较，逐用例标出 workspace 总量 / 单项或 tiling data 长度的增长，
+            存在增长时返回非零；新增与缺失的用例只做提示
+
+golden 文件格式:
+  {"<op>": {"<case>": {"workspaces": [...], "tilingDataSize": N}}}
+
+用法:
+  python3 utils/workspace_golden.py update report/tiling_results.json
+  python3 utils/workspace_golden.py diff   report/tiling_results.json --tolerance 0
+"""
+
+import argparse
+import json
+import sys
+from pathlib import Path
+from typing import Dict, List
+
+DEFAULT_GOLDEN = Path(__file__).resolve().parent.parent / "golden" / "workspace_golden.json"
+
+# op -> case -> {"workspaces": [...], "tilingDataSize": N}
+Golden = Dict[str, Dict[str, dict]]
+
+
+def load_results(path: Path) -> Golden:
+    """读取 tiling_results.json，只保留 tiling 成功的用例"""
+    records = json.loads(path.read_text(encoding="utf-8"))
+    if not isinstance(records, list):
+        raise ValueError(f"{path} 不是 tiling_results.json 格式")
+    results: Golden = {}
+    for record in records:
+        if not record.get("success"):
+            continue
+        results.setdefault(record["op"], {})[record["case"]] = {
+            "workspaces": [int(size) for size in record.get("workspaces", [])],
+            "tilingDataSize": int(record.get("tilingDataSize", 0)),
+        }
+    return results
+
+
+def load_golden(path: Path) -> Golden:
+    if not path.exists():
+        return {}
+    return json.loads(path.read_text(encoding="utf-8"))
+
+
+def format_bytes(size: int) -> str:
+    if abs(size) < 1024:
+        return f"{size}B"
+    value = float(size)
+    for unit in ("KB", "MB", "GB"):
+        value /= 1024
+        if abs(value) < 1024 or unit == "GB":
+            break
+    return f"{value:.1f}{unit}"
+
+
+def diff_case(golden: dict, current: dict, tolerance: int) -> List[str]:
+    """返回一个用例的增长项描述，为空表示没有超出容差的增长"""
+    growths = []
+    old_ws, new_ws = golden.get("workspaces", []), current["workspaces"]
+    old_total, new_total = sum(old_ws), sum(new_ws)
+    if new_total - old_total > tolerance:
+        growths.append(f"workspace 总量 {format_bytes(old_total)} -> {format_bytes(new_total)} "
+                       f"(+{format_bytes(new_total - old_total)})")
+    for index, new_size in enumerate(new_ws):
+        old_size = old_ws[index] if index < len(old_ws) else 0
+        if new_size - old_size > tolerance:
+            growths.append(f"workspace[{index}] {old_size} -> {new_size}")
+    old_len, new_len = golden.get("tilingDataSize", 0), current["tilingDataSize"]
+    if new_len > old_len:
+        growths.append(f"tiling data {old_len} -> {new_len} 字节")
+    return growths
+
+
+def cmd_update(args) -> int:
+    results = load_results(args.source)
+    golden = load_golden(args.golden)
+    for op, cases in results.items():
+        golden[op] = dict(sorted(cases.items()))
+    args.golden.parent.mkdir(parents=True, exist_ok=True)
+    args.golden.write_text(json.dumps(dict(sorted(golden.items())), ensure_ascii=False, indent=2) + "\n",
+                           encoding="utf-8")
+    total = sum(len(cases) for cases in results.values())
+    print(f"已更新 {args.golden}: {len(results)} 个算子, {total} 个用例")
+    return 0
+
+
+def cmd_diff(args) -> int:
+    results = load_results(args.source)
+    golden = load_golden(args.golden)
+    if not golden:
+        print(f"⚠️  golden 文件 {args.golden} 不存在或为空，请先执行 update")
+        return 2
+    report = []
+    for op in sorted(results):
+        if op not in golden:
+            print(f"⚠️  {op}: golden 中没有该算子，跳过")
+            continue
+        cases, golden_cases = results[op], golden[op]
+        for case in sorted(cases):
+            if case not in golden_cases:
+                report.append({"op": op, "case": case, "status": "new"})
+                continue
+            growths = diff_case(golden_cases[case], cases[case], args.tolerance)
+            if growths:
+                report.append({"op": op, "case": case, "status": "grown", "details": growths,
+                               "golden": golden_cases[case], "current": cases[case]})
+        for case in sorted(set(golden_cases) - set(cases)):
+            report.append({"op": op, "case": case, "status": "missing"})
+
+    grown = [r for r in report if r["status"] == "grown"]
+    for r in grown:
+        print(f"❌ {r['op']} / {r['case']}")
+        for detail in r["details"]:
+            print(f"     {detail}")
+    for status, label in (("new", "新增用例"), ("missing", "缺失用例 (本次未运行或 tiling 失败)")):
+        cases = [r for r in report if r["status"] == status]
+        if cases:
+            print(f"ℹ️  {label} {len(cases)} 个: " + ", ".join(f"{r['op']}/{r['case']}" for r in cases[:10])
+                  + (" ..." if len(cases) > 10 else ""))
+    if args.json:
+        args.json.write_text(json.dumps(report, ensure_ascii=False, indent=2), encoding="utf-8")
+    if grown:
+        print(f"\n❌ {len(grown)} 个用例的 device 内存需求增长")
+        return 1
+    print("\n✅ 没有用例的 workspace / tiling data 长度增长")
+    return 0
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="workspace / tiling data 长度的 golden 记录与比对")
+    parser.add_argument("--golden", type=Path, default=DEFAULT_GOLDEN,
+                        help=f"golden 文件 (默认 {DEFAULT_GOLDEN.parent.name}/{DEFAULT_GOLDEN.name})")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p_update = sub.add_parser("update", help="用本次结果更新 golden")
+    p_update.add_argument("source", type=Path, help="tiling_results.json")
+    p_update.set_defaults(func=cmd_update)
+
+    p_diff = sub.add_parser("diff", help="与 golden 比较，有增长时返回非零")
+    p_diff.add_argument("source", type=Path, help="tiling_results.json")
+    p_diff.add_argument("--tolerance", type=int, default=0, help="允许的 workspace 增长字节数 (默认 0)")
+    p_diff.add_argument("--json", type=Path, help="把比较结果写入 JSON 文件")
+    p_diff.set_defaults(func=cmd_diff)
+
+    args = parser.parse_args()
+    try:
+        sys.exit(args.func(args))
+    except (ValueError, KeyError, OSError) as e:
+        print(f"❌ {e}")
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,11 @@ UTGen-V2 工作流脚本
   python workflow.py                    # 处理所有 input 文件
   python workflow.py -n all_gather_matmul  # 只处理指定算子
   python workflow.py --list             # 列出所有可用的算子
+  python workflow.py --batched          # 生成批量执行模式的测试文件
+  python workflow.py --case-library     # 生成供常驻 runner 加载的用例库源文件
+  python workflow.py --bench            # 生成 Google Benchmark 基准测试 bench_{op_name}_tiling.cpp
+  python workflow.py --annotate-comm    # 在用例前标注通信量与带宽下限，并写出 *.comm.json 报告
+  python workflow.py --soc-profiles Ascend910B,Ascend910_93  # 每个用例按硬件 profile 各展开一份
 """
 
 import argparse
@@ -27,6 +32,8 @@ PROJECT_ROOT = Path(__file__).parent.absolute()
 INPUT_DIR = PROJECT_ROOT / "input"
 TEMPLATE_DIR = PROJECT_ROOT / "template"
 OUTPUT_DIR = PROJECT_ROOT / "outputs"
+CASE_LIB_OUTPUT_DIR = OUTPUT_DIR / "case_lib"  # 用例库源文件 (--case-library)
+BENCH_OUTPUT_DIR = OUTPUT_DIR / "bench"  # 基准测试源文件 (--bench)
 TARGET_DIR = PROJECT_ROOT / "target"  # 用于验证
 
 # 导入核心生成逻辑
@@ -72,13 +79,20 @@ def get_matching_template(op_name: str) -> Optional[Path]:
     return None
 
 
-def process_operator(op_name: str, verbose: bool = True) -> bool:
+def process_operator(op_name: str, verbose: bool = True, batched: bool = False,
+                     case_library: bool = False, bench: bool = False, annotate_comm: bool = False,
+                     soc_profiles: Optional[str] = None) -> bool:
     """
     处理单个算子，生成对应的单元测试文件。
     
     Args:
         op_name: 算子名称 (如 "all_gather_matmul")
         verbose: 是否打印详细信息
+        batched: 是否生成批量执行模式 (单个 TEST 遍历全部用例)
+        case_library: 是否生成用例库源文件 (输出到 outputs/case_lib/，编译为 .so 后由 runner 加载)
+        bench: 是否生成基准测试源文件 (输出到 outputs/bench/bench_{op_name}_tiling.cpp)
+        annotate_comm: 是否在用例前标注通信量，并在输出文件旁写出 .comm.json 报告
+        soc_profiles: 逗号分隔的硬件 profile 名 (registry/hardware_profiles.yaml)，每个用例按各 profile 展开一份
     
     Returns:
         是否成功
@@ -87,6 +101,10 @@ def process_operator(op_name: str, verbose: bool = True) -> bool:
     input_path = INPUT_DIR / f"{op_name}.jsonl"
     template_path = get_matching_template(op_name)
     output_path = OUTPUT_DIR / f"test_{op_name}_tiling.cpp"
+    if case_library:
+        output_path = CASE_LIB_OUTPUT_DIR / f"test_{op_name}_tiling_lib.cpp"
+    if bench:
+        output_path = BENCH_OUTPUT_DIR / f"bench_{op_name}_tiling.cpp"
     
     # 检查文件存在性
     if not input_path.exists():
@@ -111,11 +129,16 @@ def process_operator(op_name: str, verbose: bool = True) -> bool:
         "template_file_path": str(template_path),
         "output_path": str(output_path),
         "def_file_path": "",  # 不需要，模板已存在
+        "batched": batched,
+        "case_library": case_library,
+        "bench": bench,
+        "annotate_comm": annotate_comm,
+        "soc_profiles": soc_profiles,
     }
     
     try:
         # 确保输出目录存在
-        OUTPUT_DIR.mkdir(parents=True, exist_ok=True)
+        output_path.parent.mkdir(parents=True, exist_ok=True)
         
         # 调用核心生成逻辑
         result = generate_unit_test(state)
@@ -136,7 +159,9 @@ def process_operator(op_name: str, verbose: bool = True) -> bool:
         return False
 
 
-def process_all_operators(verbose: bool = True) -> tuple:
+def process_all_operators(verbose: bool = True, batched: bool = False, case_library: bool = False,
+                          bench: bool = False, annotate_comm: bool = False,
+                          soc_profiles: Optional[str] = None) -> tuple:
     """
     处理所有可用的算子。
     
@@ -157,7 +182,7 @@ def process_all_operators(verbose: bool = True) -> tuple:
     failed_ops = []
     
     for op_name in operators:
-        if process_operator(op_name, verbose):
+        if process_operator(op_name, verbose, batched, case_library, bench, annotate_comm, soc_profiles):
             success_count += 1
         else:
             fail_count += 1
@@ -259,6 +284,11 @@ def main():
   python workflow.py -n all_gather_matmul  # 只处理指定算子
   python workflow.py --list                # 列出所有可用算子
   python workflow.py --verify              # 验证生成结果与目标一致
+  python workflow.py --batched             # 批量执行模式，所有用例在一个 TEST 中运行
+  python workflow.py --case-library        # 用例库模式，配合 runner/case_lib.sh 热加载
+  python workflow.py --bench               # 基准测试模式，配合 runner/bench.sh 编译运行
+  python workflow.py --annotate-comm       # 用例前标注通信量与带宽下限 (utils/comm_volume.py)
+  python workflow.py --soc-profiles all    # 按全部硬件 profile 展开用例，配合 utils/soc_compare.py 比较
         """
     )
     
@@ -296,6 +326,41 @@ def main():
         help="静默模式，减少输出"
     )
     
+    parser.add_argument(
+        "--batched",
+        action="store_true",
+        help="批量执行模式：以单个 TEST 遍历全部用例，只初始化一次，失败用例汇总上报"
+    )
+    
+    parser.add_argument(
+        "--case-library",
+        dest="case_library",
+        action="store_true",
+        help="用例库模式：生成 outputs/case_lib/*_lib.cpp，编译为 .so 后由常驻 runner 热加载执行"
+    )
+    
+    parser.add_argument(
+        "--bench",
+        action="store_true",
+        help="基准测试模式：生成 outputs/bench/bench_*_tiling.cpp，每个用例注册为一个 Google Benchmark"
+    )
+    
+    parser.add_argument(
+        "--annotate-comm",
+        dest="annotate_comm",
+        action="store_true",
+        help="通信量标注：在每个用例前写入通信量、带宽下限与量化节省的注释，并在输出文件旁写出 .comm.json 报告"
+    )
+    
+    parser.add_argument(
+        "--soc-profiles",
+        dest="soc_profiles",
+        metavar="PROFILES",
+        default=None,
+        help="逗号分隔的硬件 profile 名 (registry/hardware_profiles.yaml，all 表示全部)：每个用例按各 profile "
+             "改写 soc_version / coreNum / ubSize / compile_info 后展开一份，用例名加 _<profile> 后缀；非原 SoC 的展开用例只记录结果，不断言期望值"
+    )
+    
     args = parser.parse_args()
     
     # 列出算子
@@ -317,11 +382,16 @@ def main():
             print(f"可用的算子: {', '.join(available)}")
             sys.exit(1)
         
-        success = process_operator(args.operator_name, verbose=not args.quiet)
+        success = process_operator(args.operator_name, verbose=not args.quiet, batched=args.batched,
+                                   case_library=args.case_library, bench=args.bench,
+                                   annotate_comm=args.annotate_comm, soc_profiles=args.soc_profiles)
         sys.exit(0 if success else 1)
     else:
         # 处理所有算子
-        success, fail = process_all_operators(verbose=not args.quiet)
+        success, fail = process_all_operators(verbose=not args.quiet, batched=args.batched,
+                                              case_library=args.case_library, bench=args.bench,
+                                              annotate_comm=args.annotate_comm,
+                                              soc_profiles=args.soc_profiles)
         sys.exit(0 if fail == 0 else 1)
 
 